@@ -77,99 +77,86 @@ to exclude the API function. */
 /*EDF Scheduler options */
 
 #define configUSE_EDF_SCHEDULER		1
+#define configUSE_EDF_READY_HEAP	0	/* 1 = O(log n) binary heap ready queue instead of the sorted list. */
+#define configEDF_MAX_READY_TASKS	( 128 )	/* Most tasks with the ready heap, the idle task included, see edf.h. */
+#define configUSE_EDF_TIMING_WHEEL	0	/* 1 = keep delayed tasks in a timing wheel, O(1) to block, instead of the sorted delayed list. */
+#define configUSE_EDF_BATCH_RELEASE	0	/* 1 = move the tasks released by a tick to the ready list in one sorted merge instead of one insert each. */
+#define configUSE_DEADLINE_MISS_HOOK	0	/* 1 = call vApplicationDeadlineMissHook() when a job misses its deadline. */
+#define configUSE_EDF_CBS			0	/* 1 = include xTaskCBSAttach() to serve aperiodic tasks with a Constant Bandwidth Server. */
+#define configUSE_EDF_TBS			0	/* 1 = include xTaskReleaseAperiodicFromISR() to release aperiodic jobs through a Total Bandwidth Server. */
+#define configUSE_EDF_SRP			0	/* 1 = include vTaskSRPLock() to share resources under the Stack Resource Policy. */
+#define configUSE_EDF_SHARED_STACK	0	/* 1 = include xTaskPeriodicCreateJob() to run jobs to completion on one shared stack. */
+#define configEDF_SHARED_STACK_DEPTH	( 400 )	/* Words in the stack shared by the jobs. */
+#define configUSE_EDF_BUDGET_ENFORCEMENT	0	/* 1 = include vTaskSetBudget() to limit the execution time of each job. */
+#define configUSE_BUDGET_OVERRUN_HOOK	0	/* 1 = call vApplicationBudgetOverrunHook() when a job exceeds its budget. */
+#define configEDF_CLOCK()		( T1TC )	/* Execution time is measured with Timer 1, 1 count = 1 micro second. */
 
 
 /* Run-time analysis */
 
-extern int Button_1_in_time, Button_1_out_time, Button_1_total_time  ;
-extern int Button_2_in_time  , Button_2_out_time  , Button_2_total_time  ;
-extern int Periodic_in_time  , Periodic_out_time  , Periodic_total_time  ;
-extern int UART_in_time  , UART_out_time  , UART_total_time  ;
-extern int Load_1_in_time  , Load_1_out_time  , Load_1_total_time  ;
-extern int Load_2_in_time  , Load_2_out_time  , Load_2_total_time  ;
-
-extern int system_time  ;
-extern int cpu_load  ;
-
-#define traceTASK_SWITCHED_OUT()	do{\
-										 if((int)pxCurrentTCB->pxTaskTag == 0)\
-										 {\
-											 GPIO_write(PORT_0,PIN9,PIN_IS_LOW);\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 1)\
-										 {\
-											 GPIO_write(PORT_0,PIN3,PIN_IS_LOW);\
-											 Button_1_out_time = T1TC;\
-											 Button_1_total_time += Button_1_out_time - Button_1_in_time;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 2)\
-										 {\
-											 GPIO_write(PORT_0,PIN4,PIN_IS_LOW);\
-											 Button_2_out_time = T1TC;\
-											 Button_2_total_time += Button_2_out_time - Button_2_in_time;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 3)\
-										 {\
-											 GPIO_write(PORT_0,PIN5,PIN_IS_LOW);\
-											 Periodic_out_time = T1TC;\
-											 Periodic_total_time += Periodic_out_time - Periodic_in_time;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 4)\
-										 {\
-											 GPIO_write(PORT_0,PIN6,PIN_IS_LOW);\
-											 UART_out_time = T1TC;\
-											 UART_total_time += UART_out_time - UART_in_time;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 5)\
-										 {\
-											 GPIO_write(PORT_0,PIN7,PIN_IS_LOW);\
-											 Load_1_out_time = T1TC;\
-											 Load_1_total_time += Load_1_out_time - Load_1_in_time;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 6)\
-										 {\
-											 GPIO_write(PORT_0,PIN8,PIN_IS_LOW);\
-											 Load_2_out_time = T1TC;\
-											 Load_2_total_time += Load_2_out_time - Load_2_in_time;\
-										 }\
-										 system_time = T1TC;\
-										 cpu_load = (Button_1_total_time+Button_2_total_time+Periodic_total_time+UART_total_time+Load_1_total_time+Load_2_total_time)*100/(float)system_time;\
-									 }while(0)
-
-#define traceTASK_SWITCHED_IN()		do{\
-										if((int)pxCurrentTCB->pxTaskTag == 0)\
-										 {\
-											 GPIO_write(PORT_0,PIN9,PIN_IS_HIGH);\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 1)\
-										 {\
-											 GPIO_write(PORT_0,PIN3,PIN_IS_HIGH);\
-											 Button_1_in_time = T1TC;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 2)\
-										 {\
-											 GPIO_write(PORT_0,PIN4,PIN_IS_HIGH);\
-											 Button_2_in_time = T1TC;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 3)\
-										 {\
-											 GPIO_write(PORT_0,PIN5,PIN_IS_HIGH);\
-											 Periodic_in_time  = T1TC;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 4)\
-										 {\
-											 GPIO_write(PORT_0,PIN6,PIN_IS_HIGH);\
-											 UART_in_time  = T1TC;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 5)\
-										 {\
-											 GPIO_write(PORT_0,PIN7,PIN_IS_HIGH);\
-											 Load_1_in_time  = T1TC;\
-										 }\
-										 else if((int)pxCurrentTCB->pxTaskTag == 6)\
-										 {\
-											 GPIO_write(PORT_0,PIN8,PIN_IS_HIGH);\
-											 Load_2_in_time  = T1TC;\
-										 }\
-									 }while(0)
+#define configUSE_EDF_EXECUTION_TIME	0	/* 1 = keep a 32-bit execution time of each task in its TCB, read with ulTaskGetExecutionTime() and ulTaskGetCPULoad(). */
+
+/* The kernel run time stats count Timer 1, 1 count = 1 micro second, extended
+to 64 bits in main.c as the timer wraps every 71.6 minutes.  Read them with
+uxTaskGetSystemState() or vTaskGetRunTimeStats(). */
+#define configGENERATE_RUN_TIME_STATS	1
+#define configUSE_STATS_FORMATTING_FUNCTIONS	1
+#define configRUN_TIME_COUNTER_TYPE		uint64_t
+extern void vConfigureTimerForRunTimeStats( void );
+extern uint64_t ullGetRunTimeCounterValue( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ullGetRunTimeCounterValue()
+
+#define configUSE_EDF_LOAD_WINDOW	1	/* 1 = measure the load of each window, read with ulTaskGetWindowCPULoad() and ulTaskGetAverageCPULoad(). */
+#define configEDF_LOAD_WINDOW_TICKS	( 100 )	/* Ticks in each load window. */
+#define configEDF_LOAD_EWMA_SHIFT	3	/* Each window adds 1/8 of its load to the average. */
+#define configUSE_LOAD_WINDOW_HOOK	0	/* 1 = call vApplicationLoadWindowHook() at the end of each window. */
+
+#define configUSE_EDF_TRACE_RECORDER	1	/* 1 = record scheduler events in RAM, see edf_trace.h. */
+#define configEDF_TRACE_BUFFER_LENGTH	( 256 )	/* Events in the trace buffer, 8 bytes each, a power of 2. */
+
+/* Pin driven high while a task runs, indexed by the tag given to the task with
+vTaskSetApplicationTaskTag().  The idle task has no tag and uses entry 0.  The
+table and the number of entries in it are defined in main.c, a new task only
+needs a new entry there.  A task with no tag, or a tag past the end of the
+table, has no pin and is left out of the trace. */
+extern const pinX_t xTaskTracePins[];
+extern const uint32_t ulTaskTracePinCount;
+
+#define traceTASK_TRACE_PIN( pxTCB )						( ( uint32_t ) ( pxTCB )->pxTaskTag )
+#define traceTASK_HAS_TRACE_PIN( pxTCB )					\
+	( ( traceTASK_TRACE_PIN( pxTCB ) < ulTaskTracePinCount ) &&								\
+	  ( ( ( pxTCB )->pxTaskTag != NULL ) || ( ( pxTCB ) == xIdleTaskHandle ) ) )
+
+#define traceTASK_SWITCHED_OUT()																	\
+	do																								\
+	{																								\
+		if( traceTASK_HAS_TRACE_PIN( pxCurrentTCB ) )													\
+		{																							\
+			GPIO_write( PORT_0, xTaskTracePins[ traceTASK_TRACE_PIN( pxCurrentTCB ) ], PIN_IS_LOW );	\
+		}																							\
+		edfTRACE_RECORD( edfTRACE_SWITCHED_OUT, NULL, 0U );											\
+	} while( 0 )
+#define traceTASK_SWITCHED_IN()																		\
+	do																								\
+	{																								\
+		if( traceTASK_HAS_TRACE_PIN( pxCurrentTCB ) )													\
+		{																							\
+			GPIO_write( PORT_0, xTaskTracePins[ traceTASK_TRACE_PIN( pxCurrentTCB ) ], PIN_IS_HIGH );	\
+		}																							\
+		edfTRACE_RECORD( edfTRACE_SWITCHED_IN, NULL, 0U );											\
+	} while( 0 )
+
+/* The trace recorder, only compiled in when configUSE_EDF_TRACE_RECORDER is 1.
+Tick values and queue numbers are recorded modulo 2^16. */
+#include "edf_trace.h"
+
+#define traceEDF_TASK_RELEASED( pxTCB )					edfTRACE_RECORD( edfTRACE_TASK_RELEASED, ( pxTCB ), ( pxTCB )->xTaskReleaseTime )
+#define traceEDF_DEADLINE_SET( pxTCB )					edfTRACE_RECORD( edfTRACE_DEADLINE_SET, ( pxTCB ), ( pxTCB )->xAbsoluteDeadline )
+#define traceEDF_DEADLINE_MISSED( pxTCB, xDeadline )	edfTRACE_RECORD( edfTRACE_DEADLINE_MISSED, ( pxTCB ), ( xDeadline ) )
+#define traceQUEUE_SEND( pxQueue )						edfTRACE_RECORD( edfTRACE_QUEUE_SEND, NULL, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )				edfTRACE_RECORD( edfTRACE_QUEUE_SEND, NULL, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE( pxQueue )					edfTRACE_RECORD( edfTRACE_QUEUE_RECEIVE, NULL, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )			edfTRACE_RECORD( edfTRACE_QUEUE_RECEIVE, NULL, ( pxQueue )->uxQueueNumber )
+
 #endif /* FREERTOS_CONFIG_H */
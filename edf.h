@@ -0,0 +1,688 @@
+/*
+ * EDF scheduler extensions to the FreeRTOS task API.
+ *
+ * These functions are implemented in tasks.c and are only available when
+ * configUSE_EDF_SCHEDULER is set to 1 in FreeRTOSConfig.h.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef INC_EDF_H
+#define INC_EDF_H
+
+#ifndef INC_TASK_H
+    #error "include FreeRTOS.h and task.h must appear in source files before include edf.h"
+#endif
+
+#include "edf_trace.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#ifndef configUSE_DEADLINE_MISS_HOOK
+    #define configUSE_DEADLINE_MISS_HOOK    0
+#endif
+
+/* Most tasks there can be when configUSE_EDF_READY_HEAP is 1.  The ready heap
+ * is a static array with one pointer for each, and any task can be ready, so
+ * the idle task and the timer task count too.  Creating a task past the limit
+ * fails with errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.  The sorted list used
+ * when configUSE_EDF_READY_HEAP is 0 has no limit. */
+#ifndef configEDF_MAX_READY_TASKS
+    #define configEDF_MAX_READY_TASKS    ( 128 )
+#endif
+
+#ifndef configUSE_EDF_CBS
+    #define configUSE_EDF_CBS    0
+#endif
+
+#ifndef configUSE_EDF_TBS
+    #define configUSE_EDF_TBS    0
+#endif
+
+#if ( ( configUSE_EDF_TBS == 1 ) && ( ( INCLUDE_vTaskSuspend != 1 ) || ( INCLUDE_xTaskResumeFromISR != 1 ) ) )
+    #error configUSE_EDF_TBS requires INCLUDE_vTaskSuspend and INCLUDE_xTaskResumeFromISR to be set to 1
+#endif
+
+#ifndef configUSE_EDF_SRP
+    #define configUSE_EDF_SRP    0
+#endif
+
+#ifndef configUSE_EDF_SHARED_STACK
+    #define configUSE_EDF_SHARED_STACK    0
+#endif
+
+#if ( configUSE_EDF_SHARED_STACK == 1 )
+    #ifndef configEDF_SHARED_STACK_DEPTH
+        #error configEDF_SHARED_STACK_DEPTH must be set to the size in words of the stack shared by the jobs when configUSE_EDF_SHARED_STACK is 1
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( INCLUDE_xTaskDelayUntil != 1 ) )
+        #error configUSE_EDF_SHARED_STACK requires configUSE_EDF_SCHEDULER, configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_xTaskDelayUntil to be set to 1
+    #endif
+
+    #if ( ( portSTACK_GROWTH > 0 ) || ( portUSING_MPU_WRAPPERS == 1 ) )
+        #error configUSE_EDF_SHARED_STACK requires a stack that grows down and no MPU
+    #endif
+#endif
+
+#ifndef configUSE_EDF_BUDGET_ENFORCEMENT
+    #define configUSE_EDF_BUDGET_ENFORCEMENT    0
+#endif
+
+#ifndef configUSE_BUDGET_OVERRUN_HOOK
+    #define configUSE_BUDGET_OVERRUN_HOOK    0
+#endif
+
+#ifndef configUSE_EDF_EXECUTION_TIME
+    #define configUSE_EDF_EXECUTION_TIME    0
+#endif
+
+#ifndef configUSE_EDF_LOAD_WINDOW
+    #define configUSE_EDF_LOAD_WINDOW    0
+#endif
+
+#ifndef configUSE_LOAD_WINDOW_HOOK
+    #define configUSE_LOAD_WINDOW_HOOK    0
+#endif
+
+#if ( configUSE_EDF_LOAD_WINDOW == 1 )
+    #ifndef configEDF_LOAD_WINDOW_TICKS
+        #error configEDF_LOAD_WINDOW_TICKS must be set to the length in ticks of a load window when configUSE_EDF_LOAD_WINDOW is 1
+    #endif
+
+    #ifndef configEDF_LOAD_EWMA_SHIFT
+        #define configEDF_LOAD_EWMA_SHIFT    3
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER != 1 ) || ( configGENERATE_RUN_TIME_STATS != 1 ) )
+        #error configUSE_EDF_LOAD_WINDOW requires configUSE_EDF_SCHEDULER and configGENERATE_RUN_TIME_STATS to be set to 1
+    #endif
+#endif
+
+#if ( configUSE_EDF_TRACE_RECORDER == 1 )
+    #ifndef configEDF_TRACE_BUFFER_LENGTH
+        #error configEDF_TRACE_BUFFER_LENGTH must be set to the number of events the trace buffer holds when configUSE_EDF_TRACE_RECORDER is 1
+    #endif
+
+    #if ( ( configEDF_TRACE_BUFFER_LENGTH & ( configEDF_TRACE_BUFFER_LENGTH - 1 ) ) != 0 )
+        #error configEDF_TRACE_BUFFER_LENGTH must be a power of 2
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER != 1 ) || ( configUSE_TRACE_FACILITY != 1 ) || !defined( configEDF_CLOCK ) )
+        #error configUSE_EDF_TRACE_RECORDER requires configUSE_EDF_SCHEDULER and configUSE_TRACE_FACILITY to be set to 1 and configEDF_CLOCK() to be defined
+    #endif
+#endif
+
+/* Trace points of the EDF scheduler, in addition to those of FreeRTOS.h. */
+#ifndef traceEDF_TASK_RELEASED
+
+/* Called by the tick when it moves a task out of the delayed tasks, before the
+ * task is made ready. */
+    #define traceEDF_TASK_RELEASED( pxTCB )
+#endif
+
+#ifndef traceEDF_DEADLINE_SET
+
+/* Called each time a task is made ready, once its absolute deadline is set. */
+    #define traceEDF_DEADLINE_SET( pxTCB )
+#endif
+
+#ifndef traceEDF_DEADLINE_MISSED
+
+/* Called when a job is found past its deadline, xDeadline, by the tick or
+ * when it completes. */
+    #define traceEDF_DEADLINE_MISSED( pxTCB, xDeadline )
+#endif
+
+#if ( ( ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 ) || ( configUSE_EDF_EXECUTION_TIME == 1 ) ) && !defined( configEDF_CLOCK ) )
+    #error configEDF_CLOCK() must be defined to read a free running 32-bit counter when configUSE_EDF_BUDGET_ENFORCEMENT or configUSE_EDF_EXECUTION_TIME is 1
+#endif
+
+/* Returned by xTaskPeriodicCreateConstrained() when admitting the task
+ * would overload the processor. */
+#define errTASK_NOT_SCHEDULABLE    ( -6 )
+
+/* Fixed point value of a processor density of 1, see ulTaskGetEDFDensity(). */
+#define edfDENSITY_ONE             ( ( uint32_t ) 0x1000000UL )
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* What is done when a job uses more than its execution time budget, see
+ * vTaskSetBudget(). */
+typedef enum
+{
+    eBudgetNotify = 0,  /* Nothing, other than calling vApplicationBudgetOverrunHook(). */
+    eBudgetDemote,      /* The job runs on with the deadline of the next job, behind the work due before it. */
+    eBudgetSkipNextJob, /* The job runs on with its own deadline and the next job is not released. */
+    eBudgetThrottle     /* The job is stopped until the next release and then runs on as the next job. */
+} eBudgetOverrunAction;
+
+#if ( configUSE_EDF_SRP == 1 )
+
+/* A resource shared under the Stack Resource Policy, see
+ * vTaskSRPResourceInit().  The members are only used by the kernel. */
+    typedef struct xSRP_RESOURCE
+    {
+        TickType_t xCeiling;                     /*< Shortest relative deadline of the tasks that use the resource. */
+        TickType_t xSystemCeiling;               /*< System ceiling while the resource is locked. */
+        struct xSRP_RESOURCE * pxPreviousLocked; /*< Resource locked before this one, the next one down the stack. */
+        TaskHandle_t xHolder;                    /*< Task that holds the resource, NULL while it is free. */
+    } SRPResource_t;
+#endif
+
+/* The EDF state of a task, filled in by vTaskGetEDFInfo() and, alongside the
+ * TaskStatus_t of each task, by uxTaskGetEDFSystemState(). */
+typedef struct xEDF_TASK_STATUS
+{
+    TaskHandle_t xHandle;          /* The handle of the task the rest of the information relates to. */
+    TickType_t xPeriod;            /* Period of the task in ticks, 0 for a task without a period. */
+    TickType_t xRelativeDeadline;  /* Deadline of each job in ticks from its release. */
+    TickType_t xAbsoluteDeadline;  /* Deadline the task is ordered by, see xTaskGetAbsoluteDeadline(). */
+    TickType_t xReleaseTime;       /* Tick at which the current job was, or the next job will be, released. */
+    uint32_t ulBudgetRemaining;    /* configEDF_CLOCK() counts left in the budget of the current job.  0 if the task has no budget or configUSE_EDF_BUDGET_ENFORCEMENT is 0. */
+    UBaseType_t uxDeadlineMisses;  /* Jobs of the task that missed their deadline. */
+    TickType_t xWorstLateness;     /* See vTaskGetDeadlineMissStats(). */
+} EDFTaskStatus_t;
+
+/**
+ * BaseType_t xTaskPeriodicCreateConstrained( TaskFunction_t pxTaskCode,
+ *                                            const char * const pcName,
+ *                                            configSTACK_DEPTH_TYPE usStackDepth,
+ *                                            void *pvParameters,
+ *                                            UBaseType_t uxPriority,
+ *                                            TaskHandle_t *pxCreatedTask,
+ *                                            TickType_t period,
+ *                                            TickType_t deadline,
+ *                                            TickType_t offset,
+ *                                            TickType_t wcet );
+ *
+ * Create a periodic task like xTaskPeriodicCreate(), but with a relative
+ * deadline shorter than the period, a release offset and admission control.
+ *
+ * @param period Period of the task in ticks.
+ *
+ * @param deadline Deadline of each job in ticks, counted from the release of
+ * the job.  Must not be greater than period.  0 uses the period.
+ *
+ * @param offset Release time of the first job in ticks from now.  The task
+ * does not run before that time.  Offsets de-phase tasks that have the same
+ * period so they do not all release at the same tick.
+ *
+ * The task should anchor its vTaskDelayUntil() calls on the tick at which its
+ * first job runs, which is the value returned by xTaskGetTickCount() on entry.
+ *
+ * @param wcet Worst case execution time of one job in ticks, rounded up.  The
+ * task is only created if the sum of wcet / deadline over all the tasks
+ * created with a wcet stays at or below 1.  Each share is rounded up to a
+ * multiple of 1 / edfDENSITY_ONE, so a set that loads the processor to
+ * exactly 1 can be rejected.  0 creates the task without admission control.
+ *
+ * @return pdPASS if the task was created, errTASK_NOT_SCHEDULABLE if the task
+ * set would no longer be schedulable, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY, which is also returned once
+ * configEDF_MAX_READY_TASKS tasks exist with the ready heap.
+ */
+BaseType_t xTaskPeriodicCreateConstrained( TaskFunction_t pxTaskCode,
+                                           const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                           const configSTACK_DEPTH_TYPE usStackDepth,
+                                           void * const pvParameters,
+                                           UBaseType_t uxPriority,
+                                           TaskHandle_t * const pxCreatedTask,
+                                           TickType_t period,
+                                           TickType_t deadline,
+                                           TickType_t offset,
+                                           TickType_t wcet ) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulTaskGetEDFDensity( void );
+ *
+ * @return The processor share reserved by admission control for the existing
+ * tasks, where edfDENSITY_ONE is the whole processor.  Deleting a task
+ * releases its share.
+ */
+uint32_t ulTaskGetEDFDensity( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetDeadlineMissStats( TaskHandle_t xTask,
+ *                                 UBaseType_t * const puxMisses,
+ *                                 TickType_t * const pxWorstLateness );
+ *
+ * Obtain the deadline miss counters of a task.
+ *
+ * A job misses its deadline when it has not completed (called
+ * vTaskDelayUntil()) by the tick at which its deadline falls.  Running and
+ * ready jobs are detected by the tick interrupt, jobs that were blocked past
+ * their deadline are detected when they complete.
+ *
+ * @param xTask Handle of the task to query.  Passing NULL queries the calling
+ * task.
+ *
+ * @param puxMisses Set to the number of jobs that missed their deadline since
+ * the task was created.
+ *
+ * @param pxWorstLateness Set to the largest number of ticks between the
+ * deadline and the completion of a late job.  0 with a non-zero miss count
+ * means no job was more than one tick late.
+ */
+void vTaskGetDeadlineMissStats( TaskHandle_t xTask,
+                                UBaseType_t * const puxMisses,
+                                TickType_t * const pxWorstLateness ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTaskGetEDFInfo( TaskHandle_t xTask, EDFTaskStatus_t *pxEDFStatus );
+ *
+ * Fill *pxEDFStatus with the EDF state of a task, read in one critical
+ * section.  Passing NULL as xTask queries the calling task.
+ */
+void vTaskGetEDFInfo( TaskHandle_t xTask,
+                      EDFTaskStatus_t * pxEDFStatus ) PRIVILEGED_FUNCTION;
+
+/**
+ * UBaseType_t uxTaskGetEDFSystemState( TaskStatus_t * const pxTaskStatusArray,
+ *                                      EDFTaskStatus_t * const pxEDFStatusArray,
+ *                                      const UBaseType_t uxArraySize,
+ *                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+ *
+ * configUSE_TRACE_FACILITY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Take a snapshot of the whole schedule.  pxTaskStatusArray is filled as by
+ * uxTaskGetSystemState(), and entry n of pxEDFStatusArray holds the EDF state
+ * of the task in entry n of pxTaskStatusArray.  The scheduler is suspended
+ * for the whole snapshot, so no task changes state part way through.
+ *
+ * @param uxArraySize Number of entries in each array, which must be at least
+ * uxTaskGetNumberOfTasks().
+ *
+ * @return The number of entries filled in each array, 0 if uxArraySize was
+ * too small.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+    UBaseType_t uxTaskGetEDFSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                         EDFTaskStatus_t * const pxEDFStatusArray,
+                                         const UBaseType_t uxArraySize,
+                                         configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vApplicationDeadlineMissHook( TaskHandle_t xTask, TickType_t xDeadline );
+ *
+ * Called once for each job that misses its deadline when
+ * configUSE_DEADLINE_MISS_HOOK is set to 1.  It is usually called from the
+ * tick interrupt, so it must be short and must not block.
+ */
+#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+    void vApplicationDeadlineMissHook( TaskHandle_t xTask,
+                                       TickType_t xDeadline );
+#endif
+
+/**
+ * BaseType_t xTaskCBSAttach( TaskHandle_t xTask,
+ *                            TickType_t xBudget,
+ *                            TickType_t xPeriod );
+ *
+ * configUSE_EDF_CBS must be set to 1 in FreeRTOSConfig.h for this function to
+ * be available.
+ *
+ * Serve an aperiodic task with a Constant Bandwidth Server of budget xBudget
+ * ticks every xPeriod ticks.  The task blocks on whatever signals its events
+ * (a queue, semaphore or notification) instead of polling.  Each time it is
+ * made ready it gets an EDF deadline from the CBS rules, and it can never use
+ * more than xBudget / xPeriod of the processor, so the periodic tasks keep
+ * their guarantees however often events arrive.  An event is handled at the
+ * latest by the server deadline when the budget allows it.
+ *
+ * The budget is charged one tick at a time from the tick interrupt.
+ *
+ * @param xTask Handle of a task created without a period.  Passing NULL
+ * attaches the calling task.
+ *
+ * @param xBudget Budget of the server in ticks, at least 1.
+ *
+ * @param xPeriod Period of the server in ticks, at least xBudget.
+ *
+ * @return pdPASS if the server was admitted, otherwise
+ * errTASK_NOT_SCHEDULABLE.
+ */
+#if ( configUSE_EDF_CBS == 1 )
+    BaseType_t xTaskCBSAttach( TaskHandle_t xTask,
+                               TickType_t xBudget,
+                               TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xTaskTBSSetBandwidth( TickType_t xBudget, TickType_t xPeriod );
+ *
+ * configUSE_EDF_TBS must be set to 1 in FreeRTOSConfig.h for this function and
+ * xTaskReleaseAperiodicFromISR() to be available.
+ *
+ * Reserve a bandwidth of xBudget / xPeriod of the processor for the Total
+ * Bandwidth Server.  Must be called once, before the first call to
+ * xTaskReleaseAperiodicFromISR().
+ *
+ * @return pdPASS if the bandwidth was admitted, otherwise
+ * errTASK_NOT_SCHEDULABLE.
+ */
+#if ( configUSE_EDF_TBS == 1 )
+    BaseType_t xTaskTBSSetBandwidth( TickType_t xBudget,
+                                     TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xTaskReleaseAperiodicFromISR( TaskHandle_t xTask,
+ *                                          TickType_t xWcet,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * Release one aperiodic job of xTask through the Total Bandwidth Server.  The
+ * job gets the deadline max( now, previous TBS deadline ) + xWcet / Us, where
+ * Us is the bandwidth set by xTaskTBSSetBandwidth(), and the task is moved to
+ * the ready list.  Can be called from an interrupt service routine.
+ *
+ * The task handles one job and then calls vTaskSuspend( NULL ) to wait for
+ * the next one.  The kernel does not enforce xWcet, a job that runs longer
+ * takes processor time from the other tasks.
+ *
+ * @param xTask Handle of the task that handles the job.
+ *
+ * @param xWcet Worst case execution time of the job in ticks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the released task should
+ * run before the interrupted task, in which case a context switch should be
+ * requested before the interrupt is exited.
+ *
+ * @return pdPASS if the job was released, pdFAIL if the task was still
+ * handling a previous job.
+ */
+#if ( configUSE_EDF_TBS == 1 )
+    BaseType_t xTaskReleaseAperiodicFromISR( TaskHandle_t xTask,
+                                             TickType_t xWcet,
+                                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTaskSetBudget( TaskHandle_t xTask,
+ *                      uint32_t ulBudget,
+ *                      eBudgetOverrunAction ePolicy );
+ *
+ * configUSE_EDF_BUDGET_ENFORCEMENT must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Limit the execution time of each job of a task.  Execution time is measured
+ * in configEDF_CLOCK() counts, and charged to the running task on every
+ * context switch and tick.  An overrun is therefore detected at the latest one
+ * tick after it happens.
+ *
+ * Demoting, skipping or throttling makes an overrunning job pay with the
+ * slot of the task's next job, so the other tasks keep their deadlines.  The
+ * task must complete its jobs with vTaskDelayUntil().
+ *
+ * @param xTask Handle of the task.  Passing NULL sets the budget of the
+ * calling task.
+ *
+ * @param ulBudget Execution time each job may use.  0 removes the budget.
+ *
+ * @param ePolicy What is done when a job exceeds ulBudget.  Only eBudgetNotify
+ * can be used for a task without a period.
+ */
+#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         uint32_t ulBudget,
+                         eBudgetOverrunAction ePolicy ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vApplicationBudgetOverrunHook( TaskHandle_t xTask,
+ *                                     eBudgetOverrunAction eAction );
+ *
+ * Called from the tick interrupt when a job exceeds its budget and
+ * configUSE_BUDGET_OVERRUN_HOOK is set to 1, before eAction is applied.
+ */
+#if ( ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 ) && ( configUSE_BUDGET_OVERRUN_HOOK == 1 ) )
+    void vApplicationBudgetOverrunHook( TaskHandle_t xTask,
+                                        eBudgetOverrunAction eAction );
+#endif
+
+/**
+ * void vTaskSRPResourceInit( SRPResource_t * const pxResource );
+ *
+ * configUSE_EDF_SRP must be set to 1 in FreeRTOSConfig.h for this function and
+ * the other vTaskSRP functions to be available.
+ *
+ * Initialise a resource shared under Baker's Stack Resource Policy.  Each task
+ * has a preemption level that is higher the shorter its relative deadline.  A
+ * resource has a ceiling, the highest preemption level of the tasks that use
+ * it, and while resources are locked the system ceiling is the highest ceiling
+ * among them.  A job only starts when it has the earliest deadline and a
+ * preemption level above the system ceiling.  Every resource it needs is
+ * therefore free when it starts, so locking never blocks, a job is blocked at
+ * most once, by at most one critical section of a job with a later deadline,
+ * and deadlock is impossible.  A task without a period has a relative deadline
+ * of 0, the highest preemption level.
+ *
+ * Declare every task that uses the resource with vTaskSRPResourceAddUser()
+ * before the scheduler is started.
+ */
+#if ( configUSE_EDF_SRP == 1 )
+    void vTaskSRPResourceInit( SRPResource_t * const pxResource ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTaskSRPResourceAddUser( SRPResource_t * const pxResource,
+ *                               TaskHandle_t xTask );
+ *
+ * Declare that xTask locks pxResource, which raises the ceiling of the
+ * resource to the preemption level of the task if it is higher.  Must be
+ * called after anything that changes the relative deadline of the task, such
+ * as xTaskCBSAttach().
+ */
+#if ( configUSE_EDF_SRP == 1 )
+    void vTaskSRPResourceAddUser( SRPResource_t * const pxResource,
+                                  TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTaskSRPLock( SRPResource_t * const pxResource );
+ * void vTaskSRPUnlock( SRPResource_t * const pxResource );
+ *
+ * Lock and unlock a resource.  Locking never blocks and raises the system
+ * ceiling to the ceiling of the resource.  Unlocking lowers it again and
+ * yields if a job that was held back by the ceiling can now run.
+ *
+ * Resources must be unlocked in the reverse order they were locked in, and a
+ * task must not block or complete its job while it holds a resource.
+ */
+#if ( configUSE_EDF_SRP == 1 )
+    void vTaskSRPLock( SRPResource_t * const pxResource ) PRIVILEGED_FUNCTION;
+    void vTaskSRPUnlock( SRPResource_t * const pxResource ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xTaskPeriodicCreateJob( TaskFunction_t pxJobCode,
+ *                                    const char * const pcName,
+ *                                    void *pvParameters,
+ *                                    TaskHandle_t *pxCreatedTask,
+ *                                    TickType_t period,
+ *                                    TickType_t deadline,
+ *                                    TickType_t offset,
+ *                                    TickType_t wcet );
+ *
+ * configUSE_EDF_SHARED_STACK must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Create a periodic task whose jobs run to completion on the stack shared by
+ * all such tasks, configEDF_SHARED_STACK_DEPTH words allocated by the kernel.
+ * Only the TCB is allocated, so hundreds of jobs fit in the RAM a few tasks
+ * with their own stack would take.
+ *
+ * pxJobCode is called once per job and returns when the job is done.  It
+ * must not loop or call vTaskDelayUntil(), the kernel completes the job when
+ * it returns.  Local variables do not live from one job to the next.
+ *
+ * A job's frame is placed on the shared stack when the job first runs and
+ * given back when it completes.  A job only preempts with an earlier
+ * deadline, so the jobs above a preempted job complete before it resumes and
+ * the stack is used last in, first out.  Should the ready queue pick a job
+ * that has others above it, from a tie or an inherited deadline, the job at
+ * the top of the stack runs in its place until it completes.  The shared
+ * stack must hold the deepest chain of jobs preempting each other, plus the
+ * context saved by each preemption.  Tasks created otherwise keep their own
+ * stack and mix freely with the jobs.
+ *
+ * A job must therefore never block, suspend or delete itself, and may not use
+ * the eBudgetThrottle policy.  Share resources between jobs with the
+ * vTaskSRP functions, which never block.  The port must perform the context
+ * switch on a stack of its own, as the ARM7 SWI and IRQ handlers and the
+ * Cortex-M PendSV handler do, as the stack of the job switched out may be
+ * reused by the job switched in.
+ *
+ * Jobs must be created before the scheduler is started.  The parameters are
+ * those of xTaskPeriodicCreateConstrained().  uxTaskGetStackHighWaterMark()
+ * of a job returns the high water mark of the shared stack.
+ *
+ * @return pdPASS if the job was created, errTASK_NOT_SCHEDULABLE if the task
+ * set would no longer be schedulable, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY, which is also returned once
+ * configEDF_MAX_READY_TASKS tasks exist with the ready heap.
+ */
+#if ( configUSE_EDF_SHARED_STACK == 1 )
+    BaseType_t xTaskPeriodicCreateJob( TaskFunction_t pxJobCode,
+                                       const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                       void * const pvParameters,
+                                       TaskHandle_t * const pxCreatedTask,
+                                       TickType_t period,
+                                       TickType_t deadline,
+                                       TickType_t offset,
+                                       TickType_t wcet ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTaskGetAbsoluteDeadline( TaskHandle_t xTask );
+ *
+ * @param xTask Handle of the task.  Passing NULL returns the deadline of the
+ * calling task.
+ *
+ * @return The absolute deadline, in ticks, of the job the task was last made
+ * ready for.  This is the deadline the ready queue orders the task by, so it
+ * is the inherited deadline while the task holds a mutex an earlier deadline
+ * task is blocked on.  While a periodic task waits for its next release it
+ * still returns the deadline of the job that completed.
+ */
+TickType_t xTaskGetAbsoluteDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulTaskGetExecutionTime( TaskHandle_t xTask );
+ *
+ * configUSE_EDF_EXECUTION_TIME must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Each context switch adds the time the outgoing task ran to its total, at
+ * the cost of one read of configEDF_CLOCK() and a subtraction.  The totals are
+ * 32-bit, so with a 1 MHz clock they wrap after about 71 minutes.
+ *
+ * @param xTask Handle of the task.  Passing NULL returns the time of the
+ * calling task.
+ *
+ * @return Total time the task has run since the scheduler started, in
+ * configEDF_CLOCK() counts, including the current slice if it is running.
+ */
+#if ( configUSE_EDF_EXECUTION_TIME == 1 )
+    uint32_t ulTaskGetExecutionTime( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * uint32_t ulTaskGetCPULoad( void );
+ *
+ * configUSE_EDF_EXECUTION_TIME must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @return Percentage of the time since the scheduler started that was not
+ * spent in the idle task.  Computed when called, so it costs nothing on a
+ * context switch.
+ */
+#if ( configUSE_EDF_EXECUTION_TIME == 1 )
+    uint32_t ulTaskGetCPULoad( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * uint32_t ulTaskGetWindowCPULoad( void );
+ *
+ * configUSE_EDF_LOAD_WINDOW must be set to 1 in FreeRTOSConfig.h for this
+ * function and ulTaskGetAverageCPULoad() to be available.
+ *
+ * The tick interrupt closes a window every configEDF_LOAD_WINDOW_TICKS ticks,
+ * from the run time stats of the idle task.  Setting the window to the
+ * hyperperiod of the periodic tasks gives the load of each hyperperiod.  A
+ * window in which ticks were suppressed by tickless idle lasts until the
+ * first tick after it should have ended.
+ *
+ * @return Percentage of the last complete window that was not spent in the
+ * idle task.  0 until the first window has completed.
+ */
+#if ( configUSE_EDF_LOAD_WINDOW == 1 )
+    uint32_t ulTaskGetWindowCPULoad( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * uint32_t ulTaskGetAverageCPULoad( void );
+ *
+ * @return Exponentially weighted average of the window loads, in percent.
+ * Each window adds 1 / 2^configEDF_LOAD_EWMA_SHIFT of its load, so a step in
+ * the load shows after about 2^configEDF_LOAD_EWMA_SHIFT windows.
+ */
+#if ( configUSE_EDF_LOAD_WINDOW == 1 )
+    uint32_t ulTaskGetAverageCPULoad( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vApplicationLoadWindowHook( uint32_t ulWindowLoad,
+ *                                  uint32_t ulAverageLoad );
+ *
+ * Called from the tick interrupt at the end of each load window when
+ * configUSE_LOAD_WINDOW_HOOK is set to 1, with the values the two functions
+ * above return from then on.
+ */
+#if ( ( configUSE_EDF_LOAD_WINDOW == 1 ) && ( configUSE_LOAD_WINDOW_HOOK == 1 ) )
+    void vApplicationLoadWindowHook( uint32_t ulWindowLoad,
+                                     uint32_t ulAverageLoad );
+#endif
+
+/**
+ * UBaseType_t uxTaskTraceRead( EDFTraceEvent_t * const pxEvents,
+ *                              UBaseType_t uxMaxEvents,
+ *                              uint32_t * const pulLost );
+ *
+ * configUSE_EDF_TRACE_RECORDER must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available, see edf_trace.h.
+ *
+ * Copies the oldest events not read yet, without stopping the recorder or
+ * entering a critical section.  Events the recorder overwrites while they are
+ * copied are dropped.  Only one task may read the trace.
+ *
+ * @param pxEvents Array the events are copied to, oldest first.
+ *
+ * @param uxMaxEvents Length of pxEvents.
+ *
+ * @param pulLost Set to the number of events overwritten before they could be
+ * read since the last call.  May be NULL.
+ *
+ * @return Number of events copied to pxEvents.
+ */
+#if ( configUSE_EDF_TRACE_RECORDER == 1 )
+    UBaseType_t uxTaskTraceRead( EDFTraceEvent_t * const pxEvents,
+                                 UBaseType_t uxMaxEvents,
+                                 uint32_t * const pulLost ) PRIVILEGED_FUNCTION;
+#endif
+
+#endif /* configUSE_EDF_SCHEDULER */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* INC_EDF_H */
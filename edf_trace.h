@@ -0,0 +1,92 @@
+/*
+ * Trace recorder for the EDF scheduler.
+ *
+ * Scheduler events are written to a ring buffer in RAM by the trace macros,
+ * and read back by a debugger or with uxTaskTraceRead(), see edf.h.  The
+ * recorder is implemented in tasks.c and is only available when
+ * configUSE_EDF_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h.
+ *
+ * Only standard types are used here, so FreeRTOSConfig.h can include this
+ * file and its trace macros can be expanded in any kernel source file.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef INC_EDF_TRACE_H
+#define INC_EDF_TRACE_H
+
+#include <stdint.h>
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#ifndef configUSE_EDF_TRACE_RECORDER
+    #define configUSE_EDF_TRACE_RECORDER    0
+#endif
+
+/* Events, stored in ucEvent.  usData holds the value given for each. */
+#define edfTRACE_SWITCHED_IN         ( ( uint8_t ) 1U )  /* 0. */
+#define edfTRACE_SWITCHED_OUT        ( ( uint8_t ) 2U )  /* 0. */
+#define edfTRACE_TASK_RELEASED       ( ( uint8_t ) 3U )  /* Release time of the job, the tick moved the task out of the delayed tasks. */
+#define edfTRACE_DEADLINE_SET        ( ( uint8_t ) 4U )  /* Absolute deadline the task was made ready with. */
+#define edfTRACE_DEADLINE_MISSED     ( ( uint8_t ) 5U )  /* Deadline that was missed. */
+#define edfTRACE_QUEUE_SEND          ( ( uint8_t ) 6U )  /* Queue number, see vQueueSetQueueNumber(). */
+#define edfTRACE_QUEUE_RECEIVE       ( ( uint8_t ) 7U )  /* Queue number. */
+#define edfTRACE_ISR_ENTER           ( ( uint8_t ) 8U )  /* Number given by the interrupt handler. */
+#define edfTRACE_ISR_EXIT            ( ( uint8_t ) 9U )  /* Number given by the interrupt handler. */
+
+/* Interrupt number the kernel records for the tick interrupt, around
+ * xTaskIncrementTick().  Other handlers use numbers from 1. */
+#define edfTRACE_ISR_TICK            ( 0U )
+
+/* One recorded event, 8 bytes.  Tick values are stored modulo 2^16, which is
+ * enough to place them next to the timestamp. */
+typedef struct xEDF_TRACE_EVENT
+{
+    uint32_t ulTimestamp; /*< configEDF_CLOCK() when the event was recorded. */
+    uint16_t usData;      /*< Depends on the event, see above. */
+    uint8_t ucEvent;      /*< One of the edfTRACE_ event values. */
+    uint8_t ucTask;       /*< Low 8 bits of the TCB number of the task, see uxTaskGetTaskNumber().  0 before any task exists. */
+} EDFTraceEvent_t;
+
+struct tskTaskControlBlock; /* The type TaskHandle_t points to. */
+
+/**
+ * void vTaskTraceRecord( uint8_t ucEvent,
+ *                        struct tskTaskControlBlock * xTask,
+ *                        uint16_t usData );
+ *
+ * Writes one event to the ring buffer, overwriting the oldest event once it is
+ * full.  Costs a clock read and five stores, with no critical section, so it
+ * must only be called where no other event can be recorded at the same time -
+ * from inside a critical section or from an interrupt that cannot nest, as all
+ * the trace macros of the kernel are.  Called through edfTRACE_RECORD().
+ *
+ * @param xTask The task the event is about, NULL for the running task.
+ */
+#if ( configUSE_EDF_TRACE_RECORDER == 1 )
+    void vTaskTraceRecord( uint8_t ucEvent,
+                           struct tskTaskControlBlock * xTask,
+                           uint16_t usData );
+
+    #define edfTRACE_RECORD( ucEvent, xTask, usData )    vTaskTraceRecord( ( ucEvent ), ( xTask ), ( uint16_t ) ( usData ) )
+#else
+    #define edfTRACE_RECORD( ucEvent, xTask, usData )
+#endif
+
+/* For interrupt handlers other than the tick, the ports in use do not call a
+ * trace macro on interrupt entry and exit.  Call these first and last in the
+ * handler, ucISR identifies it in the trace. */
+#define traceEDF_ISR_ENTER( ucISR )    edfTRACE_RECORD( edfTRACE_ISR_ENTER, NULL, ( ucISR ) )
+#define traceEDF_ISR_EXIT( ucISR )     edfTRACE_RECORD( edfTRACE_ISR_EXIT, NULL, ( ucISR ) )
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* INC_EDF_TRACE_H */
@@ -88,15 +88,16 @@ QueueHandle_t Button_2_Queue = NULL;
 QueueHandle_t Periodic_Transmitter_Queue = NULL;
  
 
-int Button_1_in_time = 0, Button_1_out_time = 0, Button_1_total_time = 0;
-int Button_2_in_time = 0, Button_2_out_time = 0, Button_2_total_time = 0;
-int Periodic_in_time = 0, Periodic_out_time = 0, Periodic_total_time = 0;
-int UART_in_time = 0, UART_out_time = 0, UART_total_time = 0;
-int Load_1_in_time = 0, Load_1_out_time = 0, Load_1_total_time = 0;
-int Load_2_in_time = 0, Load_2_out_time = 0, Load_2_total_time = 0;
+/* Pin toggled by traceTASK_SWITCHED_IN/OUT() for each task tag, tag 0 is the idle
+task.  The run time of each task is kept in its TCB by the kernel run time
+stats, read it with uxTaskGetSystemState() or vTaskGetRunTimeStats(). */
+const pinX_t xTaskTracePins[] = { PIN9, PIN3, PIN4, PIN5, PIN6, PIN7, PIN8 };
+const uint32_t ulTaskTracePinCount = sizeof( xTaskTracePins ) / sizeof( xTaskTracePins[ 0 ] );
 
-int system_time = 0;
-int cpu_load = 0;
+/* Upper 32 bits of the run time stats counter, and the value of T1TC when the
+tick interrupt last looked at it.  Written by the tick interrupt only. */
+static volatile uint32_t ulRunTimeHigh = 0UL;
+static volatile uint32_t ulRunTimeLastLow = 0UL;
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -105,7 +106,7 @@ int cpu_load = 0;
  */
 static void prvSetupHardware( void );
 static void configTimer1(void);
-void timer1Reset(void);
+static void prvRunTimeCounterTick( void );
 
 void Button_1_Monitor ( void * pvParameters);
 void Button_2_Monitor ( void * pvParameters);
@@ -127,7 +128,8 @@ int main( void )
 	prvSetupHardware();
 	    
 	
-	/* Create Tasks here */
+	/* Create Tasks here.  tools/edf_tasks.csv describes this task set for the
+	schedulability analyser in tools/edf_qpa.c, keep the two in step. */
 
 	 xTaskPeriodicCreate(
                     Button_1_Monitor,       /* Function that implements the task. */
@@ -141,6 +143,7 @@ int main( void )
 		vTaskSetApplicationTaskTag(Button_1_Monitor_Handler,(void *)1);
 		/* Create queue for button 1 state in order to send it to uart task */
 		Button_1_Queue = xQueueCreate(1,sizeof(char));		
+		vQueueSetQueueNumber(Button_1_Queue,1); /* Identifies the queue in the trace. */
 										
 		xTaskPeriodicCreate(
                     Button_2_Monitor,       /* Function that implements the task. */
@@ -154,6 +157,7 @@ int main( void )
 		vTaskSetApplicationTaskTag(Button_2_Monitor_Handler,(void *)2);
 		/* Create queue for button 1 state in order to send it to uart task */
 		Button_2_Queue = xQueueCreate(1,sizeof(char));
+		vQueueSetQueueNumber(Button_2_Queue,2); /* Identifies the queue in the trace. */
 		
 		xTaskPeriodicCreate(
                     Periodic_Transmitter,       /* Function that implements the task. */
@@ -167,6 +171,7 @@ int main( void )
 		vTaskSetApplicationTaskTag(Periodic_Transmitter_Handler,(void *)3);
 		/* Create queue for button 1 state in order to send it to uart task */										
 		Periodic_Transmitter_Queue = xQueueCreate(1,22*sizeof(char));
+		vQueueSetQueueNumber(Periodic_Transmitter_Queue,3); /* Identifies the queue in the trace. */
 						
 
 		xTaskPeriodicCreate(
@@ -257,14 +262,55 @@ void vApplicationStackOverflowHook( TaskHandle_t xTask,char * pcTaskName )
 void vApplicationTickHook(void)
 {
 	GPIO_write(PORT_0,PIN2,PIN_IS_HIGH);
+	prvRunTimeCounterTick();
 	GPIO_write(PORT_0,PIN2,PIN_IS_LOW);
 }
+/*-----------------------------------------------------------*/
+
+/* Timer 1 was started by prvSetupHardware() and must never be reset, the EDF
+clock and the run time stats both count on it. */
+void vConfigureTimerForRunTimeStats( void )
+{
+	ulRunTimeHigh = 0UL;
+	ulRunTimeLastLow = T1TC;
+}
+
+/* Called by the tick interrupt, far more often than Timer 1 wraps. */
+static void prvRunTimeCounterTick( void )
+{
+	const uint32_t ulLow = T1TC;
+
+	if( ulLow < ulRunTimeLastLow )
+	{
+		ulRunTimeHigh++;
+	}
 
-void timer1Reset(void)
+	ulRunTimeLastLow = ulLow;
+}
+
+/* Called on every context switch, with interrupts disabled, and from tasks.
+A task that is interrupted by the tick between reading the extension and the
+timer reads them again.  A wrap since the last tick is added here, so the
+counter never goes back. */
+uint64_t ullGetRunTimeCounterValue( void )
 {
-	T1TCR |= 0x2;
-	T1TCR &= ~0x2;
+	uint32_t ulHigh, ulLastLow, ulLow;
+
+	do
+	{
+		ulHigh = ulRunTimeHigh;
+		ulLastLow = ulRunTimeLastLow;
+		ulLow = T1TC;
+	} while( ( ulHigh != ulRunTimeHigh ) || ( ulLastLow != ulRunTimeLastLow ) );
+
+	if( ulLow < ulLastLow )
+	{
+		ulHigh++;
+	}
+
+	return ( ( uint64_t ) ulHigh << 32 ) | ( uint64_t ) ulLow;
 }
+/*-----------------------------------------------------------*/
 
 static void configTimer1(void)
 {
@@ -38,6 +38,7 @@
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "edf.h"
 #include "timers.h"
 #include "stack_macros.h"
 
@@ -115,6 +116,72 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
+/* The EDF ready queue is a deadline sorted list by default.  Setting
+ * configUSE_EDF_READY_HEAP to 1 in FreeRTOSConfig.h replaces it with a binary
+ * min-heap so that readying a task costs O(log n) instead of O(n).  The heap is
+ * a static array of configEDF_MAX_READY_TASKS entries, see edf.h.  Any task
+ * can be ready, so no more tasks than that are created. */
+#ifndef configUSE_EDF_READY_HEAP
+    #define configUSE_EDF_READY_HEAP    0
+#endif
+
+/* Delayed tasks are kept in a wake time sorted list by default, so blocking
+ * costs O(n) and the tick interrupt unblocks them one at a time.  Setting
+ * configUSE_EDF_TIMING_WHEEL to 1 keeps them in a hierarchical timing wheel
+ * instead, where blocking is O(1) and a tick only costs the tasks it moves.
+ * The wheel has configEDF_TIMING_WHEEL_LEVELS levels of
+ * 2 ^ configEDF_TIMING_WHEEL_BITS slots, each slot a List_t, and spans
+ * 2 ^ ( BITS * LEVELS ) ticks.  A task delayed for longer than that goes
+ * round the top level again. */
+#ifndef configUSE_EDF_TIMING_WHEEL
+    #define configUSE_EDF_TIMING_WHEEL    0
+#endif
+
+#ifndef configEDF_TIMING_WHEEL_BITS
+    #define configEDF_TIMING_WHEEL_BITS    4
+#endif
+
+#ifndef configEDF_TIMING_WHEEL_LEVELS
+    #define configEDF_TIMING_WHEEL_LEVELS    4
+#endif
+
+/* By default the tick interrupt moves each task it unblocks to the ready queue
+ * on its own, which with the sorted ready list walks the list once per task.
+ * Setting configUSE_EDF_BATCH_RELEASE to 1 collects the tasks released by a
+ * tick, sorts them once by deadline and merges them into the ready list in a
+ * single pass, so releasing k tasks into a queue of n costs
+ * O( k log k + n ) instead of O( k * n ).  The preemption decision is also
+ * taken once for the whole batch. */
+#ifndef configUSE_EDF_BATCH_RELEASE
+    #define configUSE_EDF_BATCH_RELEASE    0
+#endif
+
+#if ( ( configUSE_EDF_BATCH_RELEASE == 1 ) && ( configUSE_EDF_SCHEDULER != 1 ) )
+    #error configUSE_EDF_BATCH_RELEASE requires configUSE_EDF_SCHEDULER to be set to 1
+#endif
+
+#if ( configUSE_EDF_TIMING_WHEEL == 1 )
+    #if ( configUSE_EDF_SCHEDULER != 1 )
+        #error configUSE_EDF_TIMING_WHEEL requires configUSE_EDF_SCHEDULER to be set to 1
+    #endif
+
+    #if ( ( configEDF_TIMING_WHEEL_BITS * configEDF_TIMING_WHEEL_LEVELS ) > ( ( configUSE_16_BIT_TICKS == 1 ) ? 16 : 32 ) )
+        #error configEDF_TIMING_WHEEL_BITS * configEDF_TIMING_WHEEL_LEVELS must not exceed the width of TickType_t
+    #endif
+
+    #define taskEDF_WHEEL_SLOTS    ( 1U << configEDF_TIMING_WHEEL_BITS )
+    #define taskEDF_WHEEL_MASK     ( ( TickType_t ) ( taskEDF_WHEEL_SLOTS - 1U ) )
+
+/* Bit position of the slot index of a level in a tick count. */
+    #define taskEDF_WHEEL_SHIFT( uxLevel )    ( configEDF_TIMING_WHEEL_BITS * ( uxLevel ) )
+
+/* Whether pxList is one of the slots, that is whether a task whose state list
+ * item is in pxList is delayed. */
+    #define taskEDF_IN_TIMING_WHEEL( pxList )                                         \
+    ( ( ( pxList ) >= &( xTimingWheelEDF[ 0 ][ 0 ] ) ) &&                             \
+      ( ( pxList ) <= &( xTimingWheelEDF[ configEDF_TIMING_WHEEL_LEVELS - 1 ][ taskEDF_WHEEL_SLOTS - 1U ] ) ) )
+#endif
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -226,13 +293,180 @@
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 
+#define prvRemoveTaskFromStateList( pxTCB )    uxListRemove( &( ( pxTCB )->xStateListItem ) )
+
+#define prvAddWokenTaskToReadyList( pxTCB )    prvAddTaskToReadyList( pxTCB )
+
 #else
 		/************************************************************
 		 ******** EDF modification: prvAddTaskToReadyList ***********
 		 ************************************************************/
+
+/* The absolute deadline the ready queue is ordered by.  It is kept apart from
+ * the state list item value, which holds the wake time while the task is
+ * delayed or blocked. */
+#define taskEDF_DEADLINE( pxTCB )    ( ( pxTCB )->xAbsoluteDeadline )
+
+/* pdTRUE if tick value xA comes before xB.  The difference is taken modulo the
+ * tick range, so the result stays right when the tick count overflows,
+ * provided the two values are less than half the tick range apart.  The
+ * release time of a periodic task moves on with every job and a CBS deadline
+ * is at most a server period away, while a task with neither is released
+ * again each time it is woken, see taskEDF_APERIODIC_RELEASE().  A periodic
+ * task left blocked or suspended for more than half the tick range is not
+ * covered. */
+#define taskEDF_TIME_BEFORE( xA, xB )    ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+/* The absolute deadline of the current job of a task.  It is anchored on the
+ * release time of the job, not on the tick at which the task happened to be
+ * unblocked, so late unblocks and replayed pended ticks do not push it out. */
+#define taskEDF_JOB_DEADLINE( pxTCB )    ( ( pxTCB )->xTaskReleaseTime + ( pxTCB )->xTaskRelativeDeadline )
+
+/* The deadline a task is made ready with.  A mutex holder that inherited an
+ * earlier deadline from a task blocked on the mutex keeps it until it gives
+ * the mutex back, see xTaskPriorityInherit().  Deadline misses are still
+ * counted against the deadline of the job. */
+#if ( configUSE_MUTEXES == 1 )
+	#define taskEDF_READY_DEADLINE( pxTCB )																\
+		( ( ( ( pxTCB )->xDeadlineInherited != pdFALSE ) &&												\
+		    taskEDF_TIME_BEFORE( ( pxTCB )->xInheritedDeadline, taskEDF_JOB_DEADLINE( pxTCB ) ) ) ?	\
+		  ( pxTCB )->xInheritedDeadline : taskEDF_JOB_DEADLINE( pxTCB ) )
+#else
+	#define taskEDF_READY_DEADLINE( pxTCB )    taskEDF_JOB_DEADLINE( pxTCB )
+#endif
+
+/* A task served by a Constant Bandwidth Server gets the server deadline,
+ * updated by the CBS arrival rule each time a new job arrives, that is each
+ * time the task is woken.  See prvAddWokenTaskToReadyList(). */
+#if ( configUSE_EDF_CBS == 1 )
+	#define taskEDF_CBS_BUDGET( pxTCB )    ( ( pxTCB )->xCBSBudget )
+	#define taskEDF_CBS_JOB_ARRIVAL( pxTCB )								\
+		if( ( pxTCB )->xCBSBudget != ( TickType_t ) 0U )					\
+		{																	\
+			prvCBSJobArrival( pxTCB );										\
+		}
+#else
+	#define taskEDF_CBS_BUDGET( pxTCB )    ( ( TickType_t ) 0U )
+	#define taskEDF_CBS_JOB_ARRIVAL( pxTCB )
+#endif
+
+/* A task created by xTaskCreate() has neither a period nor a relative
+ * deadline, so each wake releases a new job with its deadline at the tick
+ * count.  Its deadline would otherwise stay at the tick it was created at. */
+#define taskEDF_APERIODIC_RELEASE( pxTCB )									\
+	do																	\
+	{																	\
+		if( ( ( pxTCB )->xTaskPeriod == ( TickType_t ) 0U ) &&				\
+			( ( pxTCB )->xTaskRelativeDeadline == ( TickType_t ) 0U ) )	\
+		{															\
+			( pxTCB )->xTaskReleaseTime = xTickCount;						\
+		}															\
+	} while( 0 )
+
+#if ( configUSE_EDF_READY_HEAP == 0 )
 #define prvAddTaskToReadyList( pxTCB ) /*xGenericListIteam must contain the deadline value */ \
 		traceMOVED_TASK_TO_READY_STATE( pxTCB );																									\
-		vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) )
+		( pxTCB )->xAbsoluteDeadline = taskEDF_READY_DEADLINE( pxTCB );																\
+		traceEDF_DEADLINE_SET( pxTCB );																								\
+		listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xAbsoluteDeadline );	\
+		prvEDFReadyListInsert( pxTCB )
+
+#define prvRemoveTaskFromStateList( pxTCB )    uxListRemove( &( ( pxTCB )->xStateListItem ) )
+
+#define taskEDF_HEAD_OF_READY_QUEUE()    ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xReadyTasksListEDF ) ) )
+#else
+
+/* xReadyTasksListEDF is left unordered and only records which tasks are
+ * ready, so the existing listIS_CONTAINED_WITHIN() state checks keep working.
+ * The ordering is held by the heap. */
+#define prvAddTaskToReadyList( pxTCB )                                          \
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );                                \
+		( pxTCB )->xAbsoluteDeadline = taskEDF_READY_DEADLINE( pxTCB );         \
+		traceEDF_DEADLINE_SET( pxTCB );                                         \
+		listINSERT_END( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) ); \
+		prvReadyHeapInsert( pxTCB )
+
+/* A task must leave the heap whenever its state list item leaves the EDF
+ * ready list. */
+#define prvRemoveTaskFromStateList( pxTCB )    prvEDFStateListRemove( pxTCB )
+
+#define taskEDF_HEAD_OF_READY_QUEUE()    ( pxReadyHeapEDF[ 0 ] )
+#endif /* configUSE_EDF_READY_HEAP */
+
+/* Used where a blocked, delayed or suspended task is woken, which for a task
+ * served by a CBS is the arrival of a new job.  Everywhere else a task is only
+ * moved to the position of its deadline, and keeps its server deadline and
+ * budget. */
+#define prvAddWokenTaskToReadyList( pxTCB )                                     \
+		taskEDF_APERIODIC_RELEASE( pxTCB );                                     \
+		taskEDF_CBS_JOB_ARRIVAL( pxTCB );                                       \
+		prvAddTaskToReadyList( pxTCB )
+
+#if ( configUSE_EDF_SRP == 1 )
+
+/* The system ceiling of the Stack Resource Policy, the shortest relative
+ * deadline among the ceilings of the locked resources.  portMAX_DELAY when
+ * no resource is locked. */
+#define taskEDF_SRP_SYSTEM_CEILING()    ( ( pxSRPLockedEDF != NULL ) ? pxSRPLockedEDF->xSystemCeiling : portMAX_DELAY )
+
+/* Whether the system ceiling lets a ready task run.  Its preemption level must
+ * be above the ceiling, or it must hold a resource itself, in which case it
+ * was already running when the ceiling was raised. */
+#define taskEDF_SRP_MAY_RUN( pxTCB )																			\
+		( ( ( pxTCB )->xTaskRelativeDeadline < taskEDF_SRP_SYSTEM_CEILING() ) ||								\
+		  ( ( pxTCB )->uxSRPResourcesHeld != ( UBaseType_t ) 0U ) )
+
+/* The earliest deadline task the system ceiling lets run, see
+ * prvEDFSRPSelectTask(). */
+#define taskSELECT_EARLIEST_DEADLINE_TASK()    pxCurrentTCB = prvEDFSRPSelectTask()
+#else
+
+/* The idle task is not in the ready queue.  It runs only when no EDF job is
+ * ready. */
+#define taskSELECT_EARLIEST_DEADLINE_TASK()									\
+		if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )			\
+		{																	\
+			pxCurrentTCB = taskEDF_HEAD_OF_READY_QUEUE();					\
+		}																	\
+		else																\
+		{																	\
+			pxCurrentTCB = xIdleTaskHandle;									\
+		}
+#endif /* configUSE_EDF_SRP */
+
+/* pdTRUE if a job with deadline xDeadline must preempt the running task.  Any
+ * job preempts the idle task. */
+#define taskEDF_BEFORE_CURRENT( xDeadline )									\
+		( ( pxCurrentTCB == xIdleTaskHandle ) || taskEDF_TIME_BEFORE( ( xDeadline ), taskEDF_DEADLINE( pxCurrentTCB ) ) )
+
+/* Whether a task that has just been made ready must preempt the running task,
+ * which it does only with a strictly earlier deadline.  A task held in the
+ * pending ready list is not in the ready queue yet, so the deadline of its
+ * current job is used.  The CBS arrival rule can only push that deadline out,
+ * and xTaskResumeAll() compares again when it moves the task to the ready
+ * queue.  A task still waiting for its release never preempts. */
+#define taskEDF_PREEMPTS_CURRENT( pxTCB )																		\
+		( ( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) ?		\
+		  taskEDF_BEFORE_CURRENT( taskEDF_DEADLINE( pxTCB ) ) :													\
+		  ( ( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( ( pxTCB )->xEventListItem ) ) != pdFALSE ) &&	\
+		    taskEDF_BEFORE_CURRENT( taskEDF_READY_DEADLINE( pxTCB ) ) ) )
+
+#if ( configUSE_EDF_BATCH_RELEASE == 1 )
+
+/* Used by the tick interrupt in place of prvAddTaskToReadyList().  The task
+ * gets the deadline of its new job but waits in xReleaseBatchEDF until
+ * prvEDFReleaseBatch() moves every task released by the tick to the ready
+ * queue together. */
+#define prvAddTaskToReleaseBatch( pxTCB )                                       \
+		traceMOVED_TASK_TO_READY_STATE( pxTCB );                                \
+		taskEDF_APERIODIC_RELEASE( pxTCB );                                     \
+		taskEDF_CBS_JOB_ARRIVAL( pxTCB );                                       \
+		( pxTCB )->xAbsoluteDeadline = taskEDF_READY_DEADLINE( pxTCB );         \
+		traceEDF_DEADLINE_SET( pxTCB );                                         \
+		listINSERT_END( &( xReleaseBatchEDF ), &( ( pxTCB )->xStateListItem ) )
+
+#define taskEDF_ITEM_DEADLINE( pxItem )    ( ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem ) )->xAbsoluteDeadline )
+#endif /* configUSE_EDF_BATCH_RELEASE */
 #endif
 /*-----------------------------------------------------------*/
 		
@@ -283,6 +517,52 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 		 ************************************************************/
 		#if ( configUSE_EDF_SCHEDULER == 1 )
 				TickType_t xTaskPeriod; /*< Stores the period in tick of the task. > */
+				TickType_t xTaskRelativeDeadline; /*< Deadline of each job relative to its release, never more than the period. */
+				TickType_t xTaskReleaseTime; /*< Tick at which the current job of the task was released. */
+				TickType_t xAbsoluteDeadline; /*< Deadline of the job the task was last made ready for, the key of the ready queue. */
+				UBaseType_t uxDeadlineMisses; /*< Number of jobs of the task that missed their deadline. */
+				TickType_t xWorstLateness; /*< Largest number of ticks by which a job completed after its deadline. */
+				BaseType_t xJobMissedDeadline; /*< Set once the current job has been counted as a miss so it is only counted once. */
+				uint32_t ulTaskDensity; /*< Share of the processor reserved by admission control, in units of 1 / edfDENSITY_ONE. */
+
+				#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+						uint32_t ulBudget; /*< Execution time each job may use, in configEDF_CLOCK() counts.  0 if the task has no budget. */
+						uint32_t ulBudgetUsed; /*< Execution time used by the current job, or since the budget was last recharged. */
+						eBudgetOverrunAction eBudgetPolicy; /*< What is done when the budget is exceeded. */
+						BaseType_t xBudgetExceeded; /*< Set once the policy has been applied to the current job. */
+						UBaseType_t uxJobsToSkip; /*< Jobs given up by the policy, skipped when the current job completes. */
+				#endif
+
+				#if ( configUSE_MUTEXES == 1 )
+						TickType_t xInheritedDeadline; /*< Earliest deadline of a task that blocked on a mutex the task holds. */
+						BaseType_t xDeadlineInherited; /*< pdTRUE while xInheritedDeadline applies. */
+				#endif
+
+				#if ( configUSE_EDF_SRP == 1 )
+						UBaseType_t uxSRPResourcesHeld; /*< Number of SRP resources the task holds.  A holder may run whatever the system ceiling. */
+				#endif
+
+				#if ( configUSE_EDF_SHARED_STACK == 1 )
+						TaskFunction_t pxJobCode; /*< Function run by each job of a task created with xTaskPeriodicCreateJob(), NULL for a task with its own stack. */
+						void * pvJobParameters; /*< Parameter passed to pxJobCode. */
+						TickType_t xJobLastWakeTime; /*< Wake time the jobs complete with vTaskDelayUntil(), kept here as a job's frame does not outlive it. */
+						struct tskTaskControlBlock * pxJobBelow; /*< Job whose frame is next down the shared stack, while xJobOnStack is set. */
+						BaseType_t xJobOnStack; /*< pdTRUE from the time the current job first runs until it completes. */
+				#endif
+
+				#if ( configUSE_EDF_CBS == 1 )
+						TickType_t xCBSBudget; /*< Budget of the Constant Bandwidth Server serving the task, 0 if the task is not served. */
+						TickType_t xCBSRemaining; /*< Budget left in the current server period. */
+				#endif
+
+				#if ( configUSE_EDF_READY_HEAP == 1 )
+						UBaseType_t uxReadyHeapIndex; /*< Position of the task in pxReadyHeapEDF while it is ready. */
+				#endif
+
+				#if ( configUSE_EDF_EXECUTION_TIME == 1 )
+						uint32_t ulSwitchedInTime; /*< configEDF_CLOCK() value when the task was last switched in. */
+						uint32_t ulExecutionTime; /*< Time the task has run, in configEDF_CLOCK() counts, up to its last switch out. */
+				#endif
 	  #endif
 	
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
@@ -375,6 +655,60 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 		 ***********************************************************/
 #if ( configUSE_EDF_SCHEDULER == 1 )
 PRIVILEGED_DATA static List_t xReadyTasksListEDF; /* Ready tasks ordered by their deadline. */
+PRIVILEGED_DATA static List_t xBackgroundListEDF; /*< Holds the idle task, which is never in the ready queue and runs only when it is empty. */
+PRIVILEGED_DATA static uint32_t ulTotalDensityEDF = 0UL; /*< Sum of wcet / deadline of the admitted tasks, edfDENSITY_ONE is a fully loaded processor. */
+
+	#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+		PRIVILEGED_DATA static uint32_t ulBudgetChargedTime = 0UL; /*< configEDF_CLOCK() value up to which the running task has been charged. */
+	#endif
+
+	#if ( configUSE_EDF_EXECUTION_TIME == 1 )
+		PRIVILEGED_DATA static uint32_t ulExecutionTimeNow = 0UL;   /*< configEDF_CLOCK() value read by the current context switch. */
+		PRIVILEGED_DATA static uint32_t ulExecutionTimeStart = 0UL; /*< configEDF_CLOCK() value when the scheduler started. */
+	#endif
+
+	#if ( configUSE_EDF_LOAD_WINDOW == 1 )
+		PRIVILEGED_DATA static TickType_t xLoadWindowStart = ( TickType_t ) 0U;         /*< Tick the current load window started on. */
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulLoadWindowStartTime = 0UL; /*< Run time counter when the current load window started. */
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulLoadWindowStartIdle = 0UL; /*< Run time of the idle task when the current load window started. */
+		PRIVILEGED_DATA static volatile uint32_t ulLoadWindow = 0UL;                    /*< Load of the last complete window, in percent. */
+		PRIVILEGED_DATA static volatile uint32_t ulLoadAverageSum = 0UL;                /*< Average load in percent times 2^configEDF_LOAD_EWMA_SHIFT. */
+		PRIVILEGED_DATA static BaseType_t xLoadWindowDone = pdFALSE;                    /*< pdTRUE once a window has completed and the average holds a value. */
+	#endif
+
+	#if ( configUSE_EDF_TRACE_RECORDER == 1 )
+		PRIVILEGED_DATA static volatile EDFTraceEvent_t xTraceBufferEDF[ configEDF_TRACE_BUFFER_LENGTH ]; /*< Ring buffer of the trace recorder. */
+		PRIVILEGED_DATA static volatile uint32_t ulTraceHeadEDF = 0UL; /*< Number of events recorded, the next one is written at ulTraceHeadEDF modulo the buffer length. */
+		PRIVILEGED_DATA static uint32_t ulTraceTailEDF = 0UL;          /*< Number of the next event uxTaskTraceRead() returns. */
+	#endif
+
+	#if ( configUSE_EDF_TBS == 1 )
+		PRIVILEGED_DATA static TickType_t xTBSBudget = ( TickType_t ) 0U;       /*< The Total Bandwidth Server may use xTBSBudget ticks in every xTBSPeriod ticks.  0 until xTaskTBSSetBandwidth() is called. */
+		PRIVILEGED_DATA static TickType_t xTBSPeriod = ( TickType_t ) 0U;
+		PRIVILEGED_DATA static TickType_t xTBSLastDeadline = ( TickType_t ) 0U; /*< Deadline given to the last aperiodic job released through the server. */
+	#endif
+
+	#if ( configUSE_EDF_READY_HEAP == 1 )
+		PRIVILEGED_DATA static TCB_t * pxReadyHeapEDF[ configEDF_MAX_READY_TASKS ]; /*< Binary min-heap of the ready tasks keyed on deadline - the root is the next task to run. */
+		PRIVILEGED_DATA static UBaseType_t uxReadyHeapLengthEDF = ( UBaseType_t ) 0U;
+	#endif
+
+	#if ( configUSE_EDF_SRP == 1 )
+		PRIVILEGED_DATA static SRPResource_t * pxSRPLockedEDF = NULL; /*< Last SRP resource locked, the top of the stack of locked resources.  NULL when none is locked. */
+	#endif
+
+	#if ( configUSE_EDF_SHARED_STACK == 1 )
+		PRIVILEGED_DATA static StackType_t xSharedStackEDF[ configEDF_SHARED_STACK_DEPTH ]; /*< Stack of the jobs created by xTaskPeriodicCreateJob(). */
+		PRIVILEGED_DATA static TCB_t * pxSharedStackTopEDF = NULL; /*< Job whose frame is at the top of xSharedStackEDF, NULL when no job has started. */
+	#endif
+
+	#if ( configUSE_EDF_BATCH_RELEASE == 1 )
+		PRIVILEGED_DATA static List_t xReleaseBatchEDF; /*< Tasks released by the tick being processed, in the order they were unblocked. */
+	#endif
+
+	#if ( configUSE_EDF_TIMING_WHEEL == 1 )
+		PRIVILEGED_DATA static List_t xTimingWheelEDF[ configEDF_TIMING_WHEEL_LEVELS ][ taskEDF_WHEEL_SLOTS ]; /*< Delayed tasks, used in place of pxDelayedTaskList and pxOverflowDelayedTaskList.  Slot s of level l holds the tasks moved on when bits l * BITS and up of the tick count reach s. */
+	#endif
 #endif
 
 
@@ -476,7 +810,7 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  * This does not free memory allocated by the task itself (i.e. memory
  * allocated by calls to pvPortMalloc from within the tasks application code).
  */
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
@@ -555,6 +889,117 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Inserts a task into the sorted EDF ready list.  vListInsert() orders by a
+ * plain compare of the item values, which inverts around a tick count
+ * overflow, so the list is walked with taskEDF_TIME_BEFORE() instead.  Must
+ * be called from a critical section.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 0 ) )
+
+    static void prvEDFReadyListInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Event lists are ordered by deadline under EDF, so the waiting task with the
+ * earliest deadline is the one woken by a queue or semaphore.  The item value
+ * keeps the priority, which queue.c reads back, and the list is walked on the
+ * deadlines of the owners instead.  prvEDFEventListReposition() moves a task
+ * whose deadline has changed while it waits.  Must be called as
+ * vTaskPlaceOnEventList() is.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvEDFEventListInsert( List_t * const pxEventList,
+                                       TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_MUTEXES == 1 )
+        static void prvEDFEventListReposition( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
+/*
+ * Binary heap used as the EDF ready queue when configUSE_EDF_READY_HEAP is 1.
+ * Insertion and removal are O(log n), the task with the earliest deadline is
+ * always at pxReadyHeapEDF[ 0 ].  Must be called from a critical section.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
+
+    static void prvReadyHeapInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvReadyHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static UBaseType_t prvEDFStateListRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the task to run under the Stack Resource Policy: the ready task with
+ * the earliest deadline among those the system ceiling lets run, or the idle
+ * task if none is ready.  Must be called from a critical section.
+ */
+#if ( configUSE_EDF_SRP == 1 )
+
+    static TCB_t * prvEDFSRPSelectTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Run-to-completion jobs on xSharedStackEDF.  prvSharedStackSwitchIn() is
+ * called once the next task has been selected.  It builds the frame of a job
+ * that has not started yet on top of the shared stack, and runs the job at
+ * the top of the stack in place of a job further down.  prvSharedStackJobEntry()
+ * is the task function of every job.
+ */
+#if ( configUSE_EDF_SHARED_STACK == 1 )
+
+    static void prvSharedStackSwitchIn( void ) PRIVILEGED_FUNCTION;
+
+    static portTASK_FUNCTION_PROTO( prvSharedStackJobEntry, pvParameters );
+
+#endif
+
+/*
+ * Moves the tasks collected by prvAddTaskToReleaseBatch() to the ready queue
+ * and returns pdTRUE if the earliest of them must preempt the running task.
+ * prvEDFSortBatch() sorts a NULL terminated chain of state list items, linked
+ * through pxNext, by deadline and returns its new head.  Called from the tick
+ * interrupt.
+ */
+#if ( configUSE_EDF_BATCH_RELEASE == 1 )
+
+    static BaseType_t prvEDFReleaseBatch( void ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_EDF_READY_HEAP == 0 )
+        static ListItem_t * prvEDFSortBatch( ListItem_t * pxHead ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
+/*
+ * Hierarchical timing wheel holding the delayed tasks when
+ * configUSE_EDF_TIMING_WHEEL is 1.  prvTimingWheelInsert() places a task whose
+ * state list item value is its wake time, xNextTick being the first tick the
+ * wheel has not processed yet.  prvTimingWheelTick() processes a tick and
+ * returns pdTRUE if a task it readied must preempt the running task.
+ * prvTimingWheelNextEvent() returns the next tick at which the wheel has work
+ * to do.  Must be called from a critical section or the tick interrupt.
+ */
+#if ( configUSE_EDF_TIMING_WHEEL == 1 )
+
+    static void prvTimingWheelInsert( TCB_t * pxTCB,
+                                      const TickType_t xNextTick ) PRIVILEGED_FUNCTION;
+
+    static BaseType_t prvTimingWheelTick( const TickType_t xTickNow ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        static TickType_t prvTimingWheelNextEvent( void ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 /*
@@ -566,6 +1011,17 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+/*
+ * Helper function used to print a run time counter in decimal, after a tab,
+ * whatever the width of configRUN_TIME_COUNTER_TYPE.
+ */
+    static char * prvWriteRunTimeToBuffer( char * pcBuffer,
+                                           configRUN_TIME_COUNTER_TYPE ulRunTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -581,9 +1037,87 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 /*
  * Called after a new task has been created and initialised to place the task
- * under the control of the scheduler.
+ * under the control of the scheduler.  With the EDF ready heap the task is
+ * deleted again, *pxCreatedTask set to NULL and
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY returned if the heap could not hold
+ * every task, see configEDF_MAX_READY_TASKS.  Otherwise returns pdPASS.
+ */
+static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB,
+                                            TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Holds an EDF task that is not in any state list in the delayed list until
+ * the release time of its next job.  Used for tasks created with a release
+ * offset and for tasks throttled by budget enforcement.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvDelayTaskUntilRelease( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Count a deadline miss if the current job of pxTCB is still pending at
+ * xTimeNow.  Each job is counted at most once.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvCheckDeadlineMiss( TCB_t * const pxTCB,
+                                      const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Calls prvCheckDeadlineMiss() for every ready task whose deadline is not
+ * after xTimeNow.  Only the front of the ready queue up to xTimeNow is looked
+ * at.
+ */
+    static void prvCheckReadyDeadlineMisses( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the current job of pxTCB completes at xTimeNow, before the next
+ * job is released.  Records the lateness of a job that missed its deadline.
+ */
+    static void prvRecordJobCompletion( TCB_t * const pxTCB,
+                                        const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Admission control.  Reserves wcet / deadline of the processor, rounded up,
+ * and passes the reserved share out through pulDensity.  Fails with
+ * errTASK_NOT_SCHEDULABLE if the total would exceed edfDENSITY_ONE.
+ */
+    static BaseType_t prvEDFReserveShare( TickType_t xWcet,
+                                          TickType_t xDeadline,
+                                          uint32_t * const pulDensity ) PRIVILEGED_FUNCTION;
+
+    static void prvEDFReleaseShare( uint32_t ulDensity ) PRIVILEGED_FUNCTION;
+
+/*
+ * Budget enforcement.  prvChargeBudget() adds the time since the last charge
+ * to the budget used by the running task.  prvEnforceBudget() applies the
+ * overrun policy of the running task if it has exceeded its budget, and
+ * returns pdTRUE if a context switch is required.
+ */
+    #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+        static void prvChargeBudget( void ) PRIVILEGED_FUNCTION;
+        static BaseType_t prvEnforceBudget( void ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Applies the Constant Bandwidth Server arrival rule to a task served by a
+ * CBS when it is made ready.
  */
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+    #if ( configUSE_EDF_CBS == 1 )
+        static void prvCBSJobArrival( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Called by the tick interrupt.  Closes the load window if it has lasted
+ * configEDF_LOAD_WINDOW_TICKS ticks, and folds its load into the average.
+ */
+    #if ( configUSE_EDF_LOAD_WINDOW == 1 )
+        static void prvLoadWindowTick( const TickType_t xTickNow ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
 
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
@@ -641,7 +1175,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
             prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
+            ( void ) prvAddNewTaskToReadyList( pxNewTCB, &xReturn );
         }
         else
         {
@@ -691,8 +1225,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                   pxCreatedTask, pxNewTCB,
                                   pxTaskDefinition->xRegions );
 
-            prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
+            xReturn = prvAddNewTaskToReadyList( pxNewTCB, pxCreatedTask );
         }
 
         return xReturn;
@@ -740,8 +1273,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                       pxCreatedTask, pxNewTCB,
                                       pxTaskDefinition->xRegions );
 
-                prvAddNewTaskToReadyList( pxNewTCB );
-                xReturn = pdPASS;
+                xReturn = prvAddNewTaskToReadyList( pxNewTCB, pxCreatedTask );
             }
         }
 
@@ -830,8 +1362,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
             prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-						prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
+						xReturn = prvAddNewTaskToReadyList( pxNewTCB, pxCreatedTask );
         }
         else
         {
@@ -856,9 +1387,52 @@ BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
                             UBaseType_t uxPriority,
                             TaskHandle_t * const pxCreatedTask,
 														TickType_t period)
+    {
+        /* The deadline of each job is the end of its period and the first
+         * job is released straight away.  The execution time is not known so
+         * the task is not accounted for by admission control. */
+        return xTaskPeriodicCreateConstrained( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, period, period, ( TickType_t ) 0U, ( TickType_t ) 0U );
+    }
+/*-----------------------------------------------------------*/
+
+/**************************************************************************************
+ ******** EDF modification: Periodic task with a constrained deadline and offset *****
+ **************************************************************************************/
+BaseType_t xTaskPeriodicCreateConstrained( TaskFunction_t pxTaskCode,
+                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                            const configSTACK_DEPTH_TYPE usStackDepth,
+                            void * const pvParameters,
+                            UBaseType_t uxPriority,
+                            TaskHandle_t * const pxCreatedTask,
+														TickType_t period,
+														TickType_t deadline,
+														TickType_t offset,
+														TickType_t wcet )
     {
         TCB_t * pxNewTCB;
         BaseType_t xReturn;
+        uint32_t ulDensity = 0UL;
+
+        configASSERT( period > ( TickType_t ) 0U );
+
+        /* A deadline of zero means the deadline is the end of the period.
+         * Deadlines past the end of the period are not supported as only one
+         * job of a task can be pending at a time. */
+        if( deadline == ( TickType_t ) 0U )
+        {
+            deadline = period;
+        }
+
+        configASSERT( deadline <= period );
+
+        /* Admission control.  The share of the task is reserved before
+         * anything is allocated. */
+        xReturn = prvEDFReserveShare( wcet, deadline, &ulDensity );
+
+        if( xReturn != pdPASS )
+        {
+            return xReturn;
+        }
 
         /* If the stack grows down then allocate the stack then the TCB so the stack
          * does not grow into the TCB.  Likewise if the stack grows up then allocate
@@ -925,23 +1499,125 @@ BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
                     pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
                 }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-						pxNewTCB->xTaskPeriod = period;
             prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
             
-						listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ), ( pxNewTCB)->xTaskPeriod +  xTaskGetTickCount());
+						/* The first job is released offset ticks from now.  Until then the
+						 * task waits in the delayed list, see prvAddNewTaskToReadyList(). */
+						pxNewTCB->xTaskPeriod = period;
+						pxNewTCB->xTaskRelativeDeadline = deadline;
+						pxNewTCB->xTaskReleaseTime = xTaskGetTickCount() + offset;
+						pxNewTCB->ulTaskDensity = ulDensity;
+						pxNewTCB->xAbsoluteDeadline = taskEDF_JOB_DEADLINE( pxNewTCB );
 						
 						//prvAddTaskToReadyList( pxNewTCB );
-						prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
+						xReturn = prvAddNewTaskToReadyList( pxNewTCB, pxCreatedTask );
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
+
+        if( xReturn != pdPASS )
+        {
+            /* Give back the share reserved for the task. */
+            prvEDFReleaseShare( ulDensity );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_SHARED_STACK == 1 )
+
+/**************************************************************************************
+ ******** EDF modification: Run-to-completion job on the shared stack ****************
+ **************************************************************************************/
+BaseType_t xTaskPeriodicCreateJob( TaskFunction_t pxJobCode,
+                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                            void * const pvParameters,
+                            TaskHandle_t * const pxCreatedTask,
+														TickType_t period,
+														TickType_t deadline,
+														TickType_t offset,
+														TickType_t wcet )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
+        uint32_t ulDensity = 0UL;
+
+        /* prvInitialiseNewTask() writes to the shared stack, which is in use
+         * once the scheduler has started. */
+        configASSERT( xSchedulerRunning == pdFALSE );
+        configASSERT( pxJobCode );
+        configASSERT( period > ( TickType_t ) 0U );
+
+        if( deadline == ( TickType_t ) 0U )
+        {
+            deadline = period;
+        }
+
+        configASSERT( deadline <= period );
+
+        xReturn = prvEDFReserveShare( wcet, deadline, &ulDensity );
+
+        if( xReturn != pdPASS )
+        {
+            return xReturn;
+        }
+
+        /* Only the TCB is allocated. */
+        pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+
+        if( pxNewTCB != NULL )
+        {
+            pxNewTCB->pxStack = xSharedStackEDF;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+                {
+                    /* The shared stack is not freed if the task is deleted. */
+                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+                }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            /* Priorities play no part in the scheduling of jobs.  The entry
+             * function gets the TCB, from which it finds the job function
+             * and its parameter. */
+            prvInitialiseNewTask( prvSharedStackJobEntry, pcName, ( uint32_t ) configEDF_SHARED_STACK_DEPTH, ( void * ) pxNewTCB, tskIDLE_PRIORITY + ( UBaseType_t ) 1U, pxCreatedTask, pxNewTCB, NULL );
+
+						pxNewTCB->xTaskPeriod = period;
+						pxNewTCB->xTaskRelativeDeadline = deadline;
+						pxNewTCB->xTaskReleaseTime = xTaskGetTickCount() + offset;
+						pxNewTCB->ulTaskDensity = ulDensity;
+						pxNewTCB->xAbsoluteDeadline = taskEDF_JOB_DEADLINE( pxNewTCB );
+						pxNewTCB->pxJobCode = pxJobCode;
+						pxNewTCB->pvJobParameters = pvParameters;
+						pxNewTCB->xJobLastWakeTime = pxNewTCB->xTaskReleaseTime;
+
+						xReturn = prvAddNewTaskToReadyList( pxNewTCB, pxCreatedTask );
         }
         else
         {
             xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
         }
 
+        if( xReturn != pdPASS )
+        {
+            prvEDFReleaseShare( ulDensity );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         return xReturn;
     }
 
+    #endif /* configUSE_EDF_SHARED_STACK */
+
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
@@ -1087,22 +1763,84 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         }
     #endif /* configUSE_APPLICATION_TASK_TAG */
 
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
         {
-            pxNewTCB->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
-        }
-    #endif /* configGENERATE_RUN_TIME_STATS */
+            /* A task that is not periodic has its deadline at its release
+             * time.  xTaskPeriodicCreate() overwrites these values. */
+            pxNewTCB->xTaskPeriod = ( TickType_t ) 0U;
+            pxNewTCB->xTaskRelativeDeadline = ( TickType_t ) 0U;
+            pxNewTCB->xTaskReleaseTime = xTickCount;
+            pxNewTCB->xAbsoluteDeadline = xTickCount;
+            pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+            pxNewTCB->xWorstLateness = ( TickType_t ) 0U;
+            pxNewTCB->xJobMissedDeadline = pdFALSE;
+            pxNewTCB->ulTaskDensity = 0UL;
 
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-        {
-            vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
-        }
-    #else
-        {
-            /* Avoid compiler warning about unreferenced parameter. */
-            ( void ) xRegions;
-        }
-    #endif
+            #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+                {
+                    pxNewTCB->ulBudget = 0UL;
+                    pxNewTCB->ulBudgetUsed = 0UL;
+                    pxNewTCB->eBudgetPolicy = eBudgetNotify;
+                    pxNewTCB->xBudgetExceeded = pdFALSE;
+                    pxNewTCB->uxJobsToSkip = ( UBaseType_t ) 0U;
+                }
+            #endif
+
+            #if ( configUSE_MUTEXES == 1 )
+                {
+                    pxNewTCB->xInheritedDeadline = ( TickType_t ) 0U;
+                    pxNewTCB->xDeadlineInherited = pdFALSE;
+                }
+            #endif
+
+            #if ( configUSE_EDF_SRP == 1 )
+                {
+                    pxNewTCB->uxSRPResourcesHeld = ( UBaseType_t ) 0U;
+                }
+            #endif
+
+            #if ( configUSE_EDF_SHARED_STACK == 1 )
+                {
+                    pxNewTCB->pxJobCode = NULL;
+                    pxNewTCB->pvJobParameters = NULL;
+                    pxNewTCB->xJobLastWakeTime = ( TickType_t ) 0U;
+                    pxNewTCB->pxJobBelow = NULL;
+                    pxNewTCB->xJobOnStack = pdFALSE;
+                }
+            #endif
+
+            #if ( configUSE_EDF_CBS == 1 )
+                {
+                    pxNewTCB->xCBSBudget = ( TickType_t ) 0U;
+                    pxNewTCB->xCBSRemaining = ( TickType_t ) 0U;
+                }
+            #endif
+
+            #if ( configUSE_EDF_EXECUTION_TIME == 1 )
+                {
+                    pxNewTCB->ulSwitchedInTime = 0UL;
+                    pxNewTCB->ulExecutionTime = 0UL;
+                }
+            #endif
+        }
+    #endif /* configUSE_EDF_SCHEDULER */
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxNewTCB->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+    #endif /* configGENERATE_RUN_TIME_STATS */
+
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        {
+            vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
+        }
+    #else
+        {
+            /* Avoid compiler warning about unreferenced parameter. */
+            ( void ) xRegions;
+        }
+    #endif
 
     #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
         {
@@ -1197,12 +1935,47 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 }
 /*-----------------------------------------------------------*/
 
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB,
+                                            TaskHandle_t * const pxCreatedTask )
 {
     /* Ensure interrupts don't access the task lists while the lists are being
      * updated. */
     taskENTER_CRITICAL();
     {
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
+            {
+                /* Every task may be ready at the same time, the idle task
+                 * until the scheduler starts, so the heap must have room for
+                 * all of them.  A task that deleted itself is counted until
+                 * the idle task has freed it. */
+                if( uxCurrentNumberOfTasks >= ( UBaseType_t ) configEDF_MAX_READY_TASKS )
+                {
+                    taskEXIT_CRITICAL();
+
+                    prvDeleteTCB( pxNewTCB );
+
+                    if( pxCreatedTask != NULL )
+                    {
+                        *pxCreatedTask = NULL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #else
+            {
+                ( void ) pxCreatedTask;
+            }
+        #endif /* if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) ) */
+
         uxCurrentNumberOfTasks++;
 
         if( pxCurrentTCB == NULL )
@@ -1225,21 +1998,19 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         }
         else
         {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
-            if( xSchedulerRunning == pdFALSE )
-            {
 								/*****************************************************************************
 								 ******** EDF modification: If the scheduler is not already running, *********
-								 ******** make this task the current task if it has the closest deadline *****
+								 ******** the task with the closest deadline is selected once the new  *******
+								 ******** task is in its state list, see below.                         *******
 							   *****************************************************************************/
 							
 								#if (configUSE_EDF_SCHEDULER == 0)
+            /* If the scheduler is not already running, make this task the
+             * current task if it is the highest priority task to be created
+             * so far. */
+            if( xSchedulerRunning == pdFALSE )
+            {
                 if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
-							  #else
-								if(listGET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ) ) < listGET_LIST_ITEM_VALUE( &( ( pxCurrentTCB )->xStateListItem ) ))
-								#endif
                 {
                     pxCurrentTCB = pxNewTCB;
                 }
@@ -1252,6 +2023,9 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+								#else
+            mtCOVERAGE_TEST_MARKER();
+								#endif
         }
 
         uxTaskNumber++;
@@ -1264,7 +2038,33 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         #endif /* configUSE_TRACE_FACILITY */
         traceTASK_CREATE( pxNewTCB );
 
-        prvAddTaskToReadyList( pxNewTCB );
+        #if ( configUSE_EDF_SCHEDULER == 0 )
+            prvAddTaskToReadyList( pxNewTCB );
+        #else
+            {
+                if( pxNewTCB->xTaskReleaseTime != xTickCount )
+                {
+                    /* The task was created with a release offset, so it
+                     * is held in the delayed list until its first job is
+                     * released. */
+                    prvDelayTaskUntilRelease( pxNewTCB );
+                }
+                else
+                {
+                    prvAddTaskToReadyList( pxNewTCB );
+                }
+
+                if( ( xSchedulerRunning == pdFALSE ) && ( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE ) )
+                {
+                    /* Start with the ready task that has the closest deadline. */
+                    taskSELECT_EARLIEST_DEADLINE_TASK();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_EDF_SCHEDULER */
 
         portSETUP_TCB( pxNewTCB );
     }
@@ -1274,7 +2074,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        #if ( configUSE_EDF_SCHEDULER == 0 )
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        #else
+            if( taskEDF_PREEMPTS_CURRENT( pxNewTCB ) )
+        #endif
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1287,756 +2091,966 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         mtCOVERAGE_TEST_MARKER();
     }
+
+    return pdPASS;
 }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-    void vTaskDelete( TaskHandle_t xTaskToDelete )
+    static void prvDelayTaskUntilRelease( TCB_t * pxTCB )
     {
-        TCB_t * pxTCB;
+        const TickType_t xTimeToWake = pxTCB->xTaskReleaseTime;
 
-        taskENTER_CRITICAL();
+        /* Called from within a critical section or the tick interrupt.  While
+         * delayed the list item value is the wake time.  The deadline is set
+         * when the tick moves the task to the ready list. */
+        listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTimeToWake );
+
+        if( taskEDF_TIME_BEFORE( xTickCount, xTimeToWake ) == pdFALSE )
         {
-            /* If null is passed in here then it is the calling task that is
-             * being deleted. */
-            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+            /* A throttled job that was already a period late has its next
+             * release in the past.  Compared with a plain '<' it would look
+             * like a wake time past the next overflow and wait a full tick
+             * range, so it is made ready now. */
+            prvAddTaskToReadyList( pxTCB );
+        }
 
-            /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-            {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-            }
+        #if ( configUSE_EDF_TIMING_WHEEL == 1 )
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                prvTimingWheelInsert( pxTCB, xTickCount + ( TickType_t ) 1 );
             }
-
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+        #else
+            else if( xTimeToWake < xTickCount )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                /* Wake time has overflowed.  Place this item in the overflow
+                 * list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+        #endif /* configUSE_EDF_TIMING_WHEEL */
+    }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-            if( pxTCB == pxCurrentTCB )
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvCheckDeadlineMiss( TCB_t * const pxTCB,
+                                      const TickType_t xTimeNow )
+    {
+        const TickType_t xDeadline = taskEDF_JOB_DEADLINE( pxTCB );
+
+        /* The idle task and tasks that are not periodic have no deadline to
+         * miss.  A job that has not completed when the tick count reaches its
+         * deadline has missed it. */
+        if( ( pxTCB->xTaskPeriod != ( TickType_t ) 0U ) &&
+            ( ( TaskHandle_t ) pxTCB != xIdleTaskHandle ) &&
+            ( pxTCB->xJobMissedDeadline == pdFALSE ) &&
+            ( taskEDF_TIME_BEFORE( xTimeNow, xDeadline ) == pdFALSE ) )
+        {
+            pxTCB->xJobMissedDeadline = pdTRUE;
+            ( pxTCB->uxDeadlineMisses )++;
+            traceEDF_DEADLINE_MISSED( pxTCB, xDeadline );
+
+            #if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+                {
+                    vApplicationDeadlineMissHook( ( TaskHandle_t ) pxTCB, xDeadline );
+                }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckReadyDeadlineMisses( const TickType_t xTimeNow )
+    {
+        /* A task is ready with the deadline of its job or an earlier one it
+         * inherited, so every job past its deadline sits in front of the
+         * first task whose ready deadline is after xTimeNow.  Tasks served by
+         * a CBS have no period and are never counted. */
+        #if ( configUSE_EDF_READY_HEAP == 0 )
             {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+                const ListItem_t * const pxListEnd = listGET_END_MARKER( &xReadyTasksListEDF );
+                const ListItem_t * pxIterator;
+                TCB_t * pxTCB;
 
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+                for( pxIterator = listGET_HEAD_ENTRY( &xReadyTasksListEDF ); pxIterator != pxListEnd; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
-                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
-                traceTASK_DELETE( pxTCB );
+                    if( taskEDF_TIME_BEFORE( xTimeNow, taskEDF_DEADLINE( pxTCB ) ) != pdFALSE )
+                    {
+                        break;
+                    }
 
-                /* The pre-delete hook is primarily for the Windows simulator,
-                 * in which Windows specific clean up operations are performed,
-                 * after which it is not possible to yield away from this task -
-                 * hence xYieldPending is used to latch that a context switch is
-                 * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                    prvCheckDeadlineMiss( pxTCB, xTimeNow );
+                }
             }
-            else
+        #else /* configUSE_EDF_READY_HEAP */
             {
-                --uxCurrentNumberOfTasks;
-                traceTASK_DELETE( pxTCB );
+                UBaseType_t uxIndex = ( UBaseType_t ) 0U;
 
-                /* Reset the next expected unblock time in case it referred to
-                 * the task that has just been deleted. */
-                prvResetNextTaskUnblockTime();
+                /* Depth first from the root.  No task below one whose
+                 * deadline is after xTimeNow can have an earlier one, so the
+                 * subtree is skipped.  Indexes past the end of the heap are
+                 * skipped the same way. */
+                for( ; ; )
+                {
+                    if( ( uxIndex < uxReadyHeapLengthEDF ) &&
+                        ( taskEDF_TIME_BEFORE( xTimeNow, taskEDF_DEADLINE( pxReadyHeapEDF[ uxIndex ] ) ) == pdFALSE ) )
+                    {
+                        prvCheckDeadlineMiss( pxReadyHeapEDF[ uxIndex ], xTimeNow );
+
+                        /* Down to the left child. */
+                        uxIndex = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
+                    }
+                    else
+                    {
+                        /* Up past every right child, odd indexes are left
+                         * children, then across to the right sibling. */
+                        while( ( uxIndex & ( UBaseType_t ) 1U ) == ( UBaseType_t ) 0U )
+                        {
+                            if( uxIndex == ( UBaseType_t ) 0U )
+                            {
+                                return;
+                            }
+
+                            uxIndex = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+                        }
+
+                        uxIndex++;
+                    }
+                }
             }
-        }
-        taskEXIT_CRITICAL();
+        #endif /* configUSE_EDF_READY_HEAP */
+    }
+/*-----------------------------------------------------------*/
 
-        /* If the task is not deleting itself, call prvDeleteTCB from outside of
-         * critical section. If a task deletes itself, prvDeleteTCB is called
-         * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
-        {
-            prvDeleteTCB( pxTCB );
-        }
+    static void prvRecordJobCompletion( TCB_t * const pxTCB,
+                                        const TickType_t xTimeNow )
+    {
+        const TickType_t xDeadline = taskEDF_JOB_DEADLINE( pxTCB );
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        /* A job that spent its deadline blocked was not seen by the tick, so
+         * it is counted here. */
+        prvCheckDeadlineMiss( pxTCB, xTimeNow );
+
+        if( pxTCB->xJobMissedDeadline != pdFALSE )
         {
-            if( pxTCB == pxCurrentTCB )
+            /* A lateness of 0 means the job completed within the tick
+             * period that started at its deadline. */
+            if( ( xTimeNow - xDeadline ) > pxTCB->xWorstLateness )
             {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
+                pxTCB->xWorstLateness = xTimeNow - xDeadline;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            pxTCB->xJobMissedDeadline = pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-
-#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskDelayUntil == 1 )
-
-    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
-                                const TickType_t xTimeIncrement )
+    static BaseType_t prvEDFReserveShare( TickType_t xWcet,
+                                          TickType_t xDeadline,
+                                          uint32_t * const pulDensity )
     {
-        TickType_t xTimeToWake;
-        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
-
-        configASSERT( pxPreviousWakeTime );
-        configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        BaseType_t xReturn = errTASK_NOT_SCHEDULABLE;
+        uint32_t ulDensity;
 
-        vTaskSuspendAll();
+        /* The task set stays schedulable under EDF while the sum of
+         * wcet / deadline over all tasks does not exceed 1.  This is the exact
+         * Liu and Layland bound when every deadline equals its period, and a
+         * sufficient test when deadlines are constrained.  Only the share of
+         * the new task has to be added, so admission costs the same however
+         * many tasks already exist.  The share is rounded up so rounding can
+         * never admit an overloaded set.  A zero deadline, which only a zero
+         * period can give, is refused rather than divided by. */
+        if( ( xDeadline != ( TickType_t ) 0U ) && ( xWcet <= xDeadline ) )
         {
-            /* Minor optimisation.  The tick count cannot change in this
-             * block. */
-            const TickType_t xConstTickCount = xTickCount;
-
-            /* Generate the tick time at which the task wants to wake. */
-            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+            ulDensity = ( uint32_t ) ( ( ( ( uint64_t ) xWcet * edfDENSITY_ONE ) + xDeadline - 1U ) / xDeadline );
 
-            if( xConstTickCount < *pxPreviousWakeTime )
+            taskENTER_CRITICAL();
             {
-                /* The tick count has overflowed since this function was
-                 * lasted called.  In this case the only time we should ever
-                 * actually delay is if the wake time has also  overflowed,
-                 * and the wake time is greater than the tick time.  When this
-                 * is the case it is as if neither time had overflowed. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+                if( ulDensity <= ( edfDENSITY_ONE - ulTotalDensityEDF ) )
                 {
-                    xShouldDelay = pdTRUE;
+                    /* Reserve the share now so a task created concurrently
+                     * sees it. */
+                    ulTotalDensityEDF += ulDensity;
+                    *pulDensity = ulDensity;
+                    xReturn = pdPASS;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
-            {
-                /* The tick time has not overflowed.  In this case we will
-                 * delay if either the wake time has overflowed, and/or the
-                 * tick time is less than the wake time. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
-                {
-                    xShouldDelay = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-
-            /* Update the wake time ready for the next call. */
-            *pxPreviousWakeTime = xTimeToWake;
-
-            if( xShouldDelay != pdFALSE )
-            {
-                traceTASK_DELAY_UNTIL( xTimeToWake );
-
-                /* prvAddCurrentTaskToDelayedList() needs the block time, not
-                 * the time to wake, so subtract the current tick count. */
-                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        xAlreadyYielded = xTaskResumeAll();
-
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
+            taskEXIT_CRITICAL();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        return xShouldDelay;
+        return xReturn;
     }
-
-#endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
-
-    void vTaskDelay( const TickType_t xTicksToDelay )
+    static void prvEDFReleaseShare( uint32_t ulDensity )
     {
-        BaseType_t xAlreadyYielded = pdFALSE;
-
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
-        {
-            configASSERT( uxSchedulerSuspended == 0 );
-            vTaskSuspendAll();
-            {
-                traceTASK_DELAY();
-
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
-            }
-            xAlreadyYielded = xTaskResumeAll();
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            ulTotalDensityEDF -= ulDensity;
         }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
+    #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+
+        static void prvChargeBudget( void )
         {
-            portYIELD_WITHIN_API();
+            const uint32_t ulNow = configEDF_CLOCK();
+
+            /* The clock is free running, so the unsigned difference is
+             * right across a wrap. */
+            pxCurrentTCB->ulBudgetUsed += ulNow - ulBudgetChargedTime;
+            ulBudgetChargedTime = ulNow;
         }
-        else
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvEnforceBudget( void )
         {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
+            TCB_t * const pxTCB = pxCurrentTCB;
+            BaseType_t xSwitchRequired = pdFALSE;
 
-#endif /* INCLUDE_vTaskDelay */
-/*-----------------------------------------------------------*/
+            if( ( pxTCB->ulBudget != 0UL ) &&
+                ( pxTCB->xBudgetExceeded == pdFALSE ) &&
+                ( pxTCB->ulBudgetUsed > pxTCB->ulBudget ) )
+            {
+                pxTCB->xBudgetExceeded = pdTRUE;
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+                #if ( configUSE_BUDGET_OVERRUN_HOOK == 1 )
+                    {
+                        vApplicationBudgetOverrunHook( ( TaskHandle_t ) pxTCB, pxTCB->eBudgetPolicy );
+                    }
+                #endif
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
-    {
-        eTaskState eReturn;
-        List_t const * pxStateList, * pxDelayedList, * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
+                switch( pxTCB->eBudgetPolicy )
+                {
+                    case eBudgetSkipNextJob:
 
-        configASSERT( pxTCB );
+                        /* The job runs on at its own deadline and the time it
+                         * takes is paid back by its next job. */
+                        ( pxTCB->uxJobsToSkip )++;
+                        break;
 
-        if( pxTCB == pxCurrentTCB )
-        {
-            /* The task calling this function is querying its own state. */
-            eReturn = eRunning;
+                    case eBudgetDemote:
+                    case eBudgetThrottle:
+
+                        /* The job takes over the slot of the next job: its
+                         * release and deadline move one period on and it gets
+                         * that period's budget. */
+                        ( pxTCB->uxJobsToSkip )++;
+                        pxTCB->xTaskReleaseTime += pxTCB->xTaskPeriod;
+                        pxTCB->ulBudgetUsed = 0UL;
+                        pxTCB->xBudgetExceeded = pdFALSE;
+
+                        ( void ) prvRemoveTaskFromStateList( pxTCB );
+
+                        if( pxTCB->eBudgetPolicy == eBudgetDemote )
+                        {
+                            /* Only runs in time the jobs due before its new
+                             * deadline do not need. */
+                            prvAddTaskToReadyList( pxTCB );
+                        }
+                        else
+                        {
+                            /* Does not run again before the new release. */
+                            prvDelayTaskUntilRelease( pxTCB );
+                        }
+
+                        xSwitchRequired = pdTRUE;
+                        break;
+
+                    case eBudgetNotify:
+                    default:
+                        mtCOVERAGE_TEST_MARKER();
+                        break;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xSwitchRequired;
         }
-        else
+/*-----------------------------------------------------------*/
+
+        void vTaskSetBudget( TaskHandle_t xTask,
+                             uint32_t ulBudget,
+                             eBudgetOverrunAction ePolicy )
         {
+            TCB_t * pxTCB;
+
+            /* If null is passed in here then the budget of the calling task is
+             * being set. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Only notification makes sense for a task without a period. */
+            configASSERT( ( ePolicy == eBudgetNotify ) || ( pxTCB->xTaskPeriod != ( TickType_t ) 0U ) );
+
+            #if ( configUSE_EDF_SHARED_STACK == 1 )
+                {
+                    /* Throttling stops a job part way, which a job on the
+                     * shared stack cannot be. */
+                    configASSERT( ( ePolicy != eBudgetThrottle ) || ( pxTCB->pxJobCode == NULL ) );
+                }
+            #endif
+
             taskENTER_CRITICAL();
             {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                pxTCB->ulBudget = ulBudget;
+                pxTCB->eBudgetPolicy = ePolicy;
             }
             taskEXIT_CRITICAL();
+        }
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+    #endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_CBS == 1 )
+
+        static void prvCBSJobArrival( TCB_t * const pxTCB )
+        {
+            const TickType_t xTimeNow = xTickCount;
+            const TickType_t xDeadline = taskEDF_JOB_DEADLINE( pxTCB );
+
+            /* While served by a CBS the release time of the task is the start
+             * of the current server period, so the deadline above is the
+             * server deadline and xTaskRelativeDeadline is the server period.
+             * The remaining budget can be used up to the current deadline
+             * only if that does not exceed the server bandwidth, that is if
+             * remaining < ( deadline - now ) * budget / period.  Otherwise a
+             * new server period starts now with a full budget.  A deadline
+             * that has passed, or that lies more than a server period ahead
+             * because it was set before the tick count last wrapped, is
+             * replaced too. */
+            if( ( ( TickType_t ) ( xDeadline - xTimeNow ) > pxTCB->xTaskRelativeDeadline ) ||
+                ( ( ( uint64_t ) pxTCB->xCBSRemaining * pxTCB->xTaskRelativeDeadline ) >=
+                  ( ( uint64_t ) ( xDeadline - xTimeNow ) * pxTCB->xCBSBudget ) ) )
             {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
+                pxTCB->xTaskReleaseTime = xTimeNow;
+                pxTCB->xCBSRemaining = pxTCB->xCBSBudget;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+/*-----------------------------------------------------------*/
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
-                {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                            {
-                                BaseType_t x;
+        BaseType_t xTaskCBSAttach( TaskHandle_t xTask,
+                                   TickType_t xBudget,
+                                   TickType_t xPeriod )
+        {
+            TCB_t * pxTCB;
+            BaseType_t xReturn;
+            uint32_t ulDensity = 0UL;
 
-                                /* The task does not appear on the event list item of
-                                 * and of the RTOS objects, but could still be in the
-                                 * blocked state if it is waiting on its notification
-                                 * rather than waiting on an object.  If not, is
-                                 * suspended. */
-                                eReturn = eSuspended;
+            configASSERT( xBudget > ( TickType_t ) 0U );
+            configASSERT( xBudget <= xPeriod );
 
-                                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                                {
-                                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                                    {
-                                        eReturn = eBlocked;
-                                        break;
-                                    }
-                                }
-                            }
-                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                            {
-                                eReturn = eSuspended;
-                            }
-                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+            /* If null is passed in here then the calling task is attached. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Only tasks without a period can be served, and only once. */
+            configASSERT( pxTCB->xTaskPeriod == ( TickType_t ) 0U );
+            configASSERT( pxTCB->xCBSBudget == ( TickType_t ) 0U );
+
+            /* The server is admitted like a periodic task with a wcet of the
+             * budget.  Whatever the served task does, it cannot use more. */
+            xReturn = prvEDFReserveShare( xBudget, xPeriod, &ulDensity );
+
+            if( xReturn == pdPASS )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxTCB->ulTaskDensity = ulDensity;
+                    pxTCB->xCBSBudget = xBudget;
+                    pxTCB->xCBSRemaining = xBudget;
+                    pxTCB->xTaskRelativeDeadline = xPeriod;
+                    pxTCB->xTaskReleaseTime = xTickCount;
+
+                    /* A ready task moves to its server deadline. */
+                    if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        ( void ) prvRemoveTaskFromStateList( pxTCB );
+                        prvAddTaskToReadyList( pxTCB );
                     }
                     else
                     {
-                        eReturn = eBlocked;
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
-
-            #if ( INCLUDE_vTaskDelete == 1 )
-                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
-                {
-                    /* The task being queried is referenced from the deleted
-                     * tasks list, or it is not referenced from any lists at
-                     * all. */
-                    eReturn = eDeleted;
-                }
-            #endif
-
-            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+                taskEXIT_CRITICAL();
+            }
+            else
             {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
+                mtCOVERAGE_TEST_MARKER();
             }
-        }
 
-        return eReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+            return xReturn;
+        }
 
-#endif /* INCLUDE_eTaskGetState */
+    #endif /* configUSE_EDF_CBS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
-
-    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
-    {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn;
+    #if ( configUSE_EDF_TBS == 1 )
 
-        taskENTER_CRITICAL();
+        BaseType_t xTaskTBSSetBandwidth( TickType_t xBudget,
+                                         TickType_t xPeriod )
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
-        }
-        taskEXIT_CRITICAL();
+            BaseType_t xReturn;
+            uint32_t ulDensity = 0UL;
 
-        return uxReturn;
-    }
+            configASSERT( xBudget > ( TickType_t ) 0U );
+            configASSERT( xBudget <= xPeriod );
 
-#endif /* INCLUDE_uxTaskPriorityGet */
+            /* The bandwidth can only be set once as it is never given back. */
+            configASSERT( xTBSBudget == ( TickType_t ) 0U );
+
+            xReturn = prvEDFReserveShare( xBudget, xPeriod, &ulDensity );
+
+            if( xReturn == pdPASS )
+            {
+                taskENTER_CRITICAL();
+                {
+                    xTBSBudget = xBudget;
+                    xTBSPeriod = xPeriod;
+                    xTBSLastDeadline = xTickCount;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+        BaseType_t xTaskReleaseAperiodicFromISR( TaskHandle_t xTask,
+                                                 TickType_t xWcet,
+                                                 BaseType_t * const pxHigherPriorityTaskWoken )
+        {
+            TCB_t * const pxTCB = xTask;
+            BaseType_t xReturn = pdFAIL;
+            UBaseType_t uxSavedInterruptStatus;
+            TickType_t xReleaseTime;
 
-    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
-    {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn, uxSavedInterruptState;
+            configASSERT( xTask );
+            configASSERT( xTBSBudget != ( TickType_t ) 0U );
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
-
-        return uxReturn;
-    }
-
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskPrioritySet == 1 )
-
-    void vTaskPrioritySet( TaskHandle_t xTask,
-                           UBaseType_t uxNewPriority )
-    {
-        TCB_t * pxTCB;
-        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
-        BaseType_t xYieldRequired = pdFALSE;
-
-        configASSERT( uxNewPriority < configMAX_PRIORITIES );
-
-        /* Ensure the new priority is valid. */
-        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
-        {
-            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+            /* See the comment in xTaskResumeFromISR(). */
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        taskENTER_CRITICAL();
-        {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being changed. */
-            pxTCB = prvGetTCBFromHandle( xTask );
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                /* A job can only be released once the task has completed
+                 * the previous one and suspended itself. */
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    /* d(k) = max( r(k), d(k-1) ) + C(k) / Us, Us being
+                     * xTBSBudget / xTBSPeriod.  The job is kept from using
+                     * more than the server bandwidth by pushing its deadline
+                     * out, so the periodic tasks keep their guarantees. */
+                    xReleaseTime = xTickCount;
 
-            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+                    if( taskEDF_TIME_BEFORE( xReleaseTime, xTBSLastDeadline ) )
+                    {
+                        xReleaseTime = xTBSLastDeadline;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-            #if ( configUSE_MUTEXES == 1 )
-                {
-                    uxCurrentBasePriority = pxTCB->uxBasePriority;
+                    pxTCB->xTaskReleaseTime = xReleaseTime;
+                    pxTCB->xTaskRelativeDeadline = ( TickType_t ) ( ( ( ( uint64_t ) xWcet * xTBSPeriod ) + xTBSBudget - 1U ) / xTBSBudget );
+                    xTBSLastDeadline = taskEDF_JOB_DEADLINE( pxTCB );
+                    xReturn = pdPASS;
                 }
-            #else
+                else
                 {
-                    uxCurrentBasePriority = pxTCB->uxPriority;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            #endif
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-            if( uxCurrentBasePriority != uxNewPriority )
+            if( xReturn != pdFAIL )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
+                /* Move the task to the ready list at its new deadline. */
+                if( xTaskResumeFromISR( xTask ) != pdFALSE )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    if( pxHigherPriorityTaskWoken != NULL )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
-                        {
-                            xYieldRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        *pxHigherPriorityTaskWoken = pdTRUE;
                     }
                     else
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else if( pxTCB == pxCurrentTCB )
-                {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
                 else
                 {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
+                    mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                /* Remember the ready list the task might be referenced from
-                 * before its uxPriority member is changed so the
-                 * taskRESET_READY_PRIORITY() macro can function correctly. */
-                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+            return xReturn;
+        }
 
-                #if ( configUSE_MUTEXES == 1 )
-                    {
-                        /* Only change the priority being used if the task is not
-                         * currently using an inherited priority. */
-                        if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+    #endif /* configUSE_EDF_TBS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_SRP == 1 )
+
+        static TCB_t * prvEDFSRPSelectTask( void )
+        {
+            TCB_t * pxTCB;
+            TCB_t * pxSelected;
+
+            if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) != pdFALSE )
+            {
+                pxSelected = xIdleTaskHandle;
+            }
+            else
+            {
+                pxSelected = taskEDF_HEAD_OF_READY_QUEUE();
+
+                if( ( pxSRPLockedEDF != NULL ) && ( taskEDF_SRP_MAY_RUN( pxSelected ) == pdFALSE ) )
+                {
+                    /* The earliest deadline is held back by the ceiling.  The
+                     * holder of the last locked resource is ready, as it may
+                     * not block, and has a later deadline than every held
+                     * back task, so the search ends there at the latest. */
+                    #if ( configUSE_EDF_READY_HEAP == 0 )
                         {
-                            pxTCB->uxPriority = uxNewPriority;
+                            const ListItem_t * pxItem = listGET_NEXT( &( pxSelected->xStateListItem ) );
+                            const ListItem_t * const pxListEnd = listGET_END_MARKER( &xReadyTasksListEDF );
+
+                            pxSelected = NULL;
+
+                            for( ; pxItem != pxListEnd; pxItem = listGET_NEXT( pxItem ) )
+                            {
+                                pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+                                if( taskEDF_SRP_MAY_RUN( pxTCB ) != pdFALSE )
+                                {
+                                    pxSelected = pxTCB;
+                                    break;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
                         }
-                        else
+                    #else /* configUSE_EDF_READY_HEAP */
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            UBaseType_t uxIndex;
+
+                            /* The heap is only ordered from parent to child,
+                             * so every ready task is looked at. */
+                            pxSelected = NULL;
+
+                            for( uxIndex = ( UBaseType_t ) 1U; uxIndex < uxReadyHeapLengthEDF; uxIndex++ )
+                            {
+                                pxTCB = pxReadyHeapEDF[ uxIndex ];
+
+                                if( ( taskEDF_SRP_MAY_RUN( pxTCB ) != pdFALSE ) &&
+                                    ( ( pxSelected == NULL ) || ( taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxTCB ), taskEDF_DEADLINE( pxSelected ) ) != pdFALSE ) ) )
+                                {
+                                    pxSelected = pxTCB;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
                         }
+                    #endif /* configUSE_EDF_READY_HEAP */
 
-                        /* The base priority gets set whatever. */
-                        pxTCB->uxBasePriority = uxNewPriority;
+                    if( pxSelected == NULL )
+                    {
+                        /* Only possible if the holder has been suspended or
+                         * deleted.  Run the earliest deadline rather than
+                         * nothing. */
+                        pxSelected = taskEDF_HEAD_OF_READY_QUEUE();
                     }
-                #else /* if ( configUSE_MUTEXES == 1 ) */
+                    else
                     {
-                        pxTCB->uxPriority = uxNewPriority;
+                        mtCOVERAGE_TEST_MARKER();
                     }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
-
-                /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
 
-                /* If the task is in the blocked or suspended list we need do
-                 * nothing more than change its priority variable. However, if
-                 * the task is in a ready list it needs to be removed and placed
-                 * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    /* The task is currently in its ready list - remove before
-                     * adding it to its new ready list.  As we are in a critical
-                     * section we can do this even if the scheduler is suspended. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+            return pxSelected;
+        }
+/*-----------------------------------------------------------*/
 
-                    prvAddTaskToReadyList( pxTCB );
+        void vTaskSRPResourceInit( SRPResource_t * const pxResource )
+        {
+            configASSERT( pxResource );
+
+            pxResource->xCeiling = portMAX_DELAY;
+            pxResource->xSystemCeiling = portMAX_DELAY;
+            pxResource->pxPreviousLocked = NULL;
+            pxResource->xHolder = NULL;
+        }
+/*-----------------------------------------------------------*/
+
+        void vTaskSRPResourceAddUser( SRPResource_t * const pxResource,
+                                      TaskHandle_t xTask )
+        {
+            TCB_t * pxTCB;
+
+            configASSERT( pxResource );
+
+            /* If null is passed in here then the calling task is declared. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            taskENTER_CRITICAL();
+            {
+                /* The ceiling can only be raised while the resource is free,
+                 * or the system ceiling taken when it was locked is wrong. */
+                configASSERT( pxResource->xHolder == NULL );
+
+                if( pxTCB->xTaskRelativeDeadline < pxResource->xCeiling )
+                {
+                    pxResource->xCeiling = pxTCB->xTaskRelativeDeadline;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
 
-                if( xYieldRequired != pdFALSE )
+        void vTaskSRPLock( SRPResource_t * const pxResource )
+        {
+            configASSERT( pxResource );
+
+            taskENTER_CRITICAL();
+            {
+                /* The task must have been declared as a user, and the ceiling
+                 * has kept every other user from starting while the resource
+                 * is held. */
+                configASSERT( pxCurrentTCB->xTaskRelativeDeadline >= pxResource->xCeiling );
+                configASSERT( pxResource->xHolder == NULL );
+
+                pxResource->xHolder = pxCurrentTCB;
+                pxResource->xSystemCeiling = taskEDF_SRP_SYSTEM_CEILING();
+
+                if( pxResource->xCeiling < pxResource->xSystemCeiling )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    pxResource->xSystemCeiling = pxResource->xCeiling;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
+                pxResource->pxPreviousLocked = pxSRPLockedEDF;
+                pxSRPLockedEDF = pxResource;
+                ( pxCurrentTCB->uxSRPResourcesHeld )++;
             }
+            taskEXIT_CRITICAL();
         }
-        taskEXIT_CRITICAL();
-    }
-
-#endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
-
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
-    {
-        TCB_t * pxTCB;
-
-        taskENTER_CRITICAL();
+        void vTaskSRPUnlock( SRPResource_t * const pxResource )
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+            BaseType_t xYieldRequired;
 
-            traceTASK_SUSPEND( pxTCB );
+            configASSERT( pxResource );
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-            {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-            }
-            else
+            taskENTER_CRITICAL();
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Resources are released in the reverse order they were
+                 * locked in, which the stack of locked resources relies on. */
+                configASSERT( pxResource->xHolder == pxCurrentTCB );
+                configASSERT( pxSRPLockedEDF == pxResource );
+
+                pxSRPLockedEDF = pxResource->pxPreviousLocked;
+                pxResource->pxPreviousLocked = NULL;
+                pxResource->xHolder = NULL;
+                ( pxCurrentTCB->uxSRPResourcesHeld )--;
+
+                /* A job held back by the ceiling may be able to run now. */
+                xYieldRequired = ( prvEDFSRPSelectTask() != pxCurrentTCB ) ? pdTRUE : pdFALSE;
             }
+            taskEXIT_CRITICAL();
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            if( xYieldRequired != pdFALSE )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                taskYIELD_IF_USING_PREEMPTION();
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+        }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+    #endif /* configUSE_EDF_SRP */
+/*-----------------------------------------------------------*/
 
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                {
-                    BaseType_t x;
-
-                    for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                    {
-                        if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                        {
-                            /* The task was blocked to wait for a notification, but is
-                             * now suspended, so no notification was received. */
-                            pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
-                        }
-                    }
-                }
-            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
+    #if ( configUSE_EDF_SHARED_STACK == 1 )
 
-        if( xSchedulerRunning != pdFALSE )
+        static void prvSharedStackSwitchIn( void )
         {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
+            StackType_t * pxTopOfStack;
+
+            if( pxCurrentTCB->pxJobCode == NULL )
             {
-                prvResetNextTaskUnblockTime();
+                /* The task has a stack of its own. */
+                mtCOVERAGE_TEST_MARKER();
             }
-            taskEXIT_CRITICAL();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        if( pxTCB == pxCurrentTCB )
-        {
-            if( xSchedulerRunning != pdFALSE )
+            else if( pxCurrentTCB->xJobOnStack != pdFALSE )
             {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
+                /* A started job resumes from the context it saved, which is
+                 * only possible once the jobs above it have completed.  A job
+                 * preempts only with an earlier deadline, so a job further
+                 * down is selected only on a tie or through an inherited
+                 * deadline.  The top job cannot block and runs in its place. */
+                pxCurrentTCB = pxSharedStackTopEDF;
             }
             else
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                /* The job starts.  Its frame goes below the context saved by
+                 * the job at the top of the stack, or at the base of the stack
+                 * if no job has started. */
+                if( pxSharedStackTopEDF != NULL )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    pxTopOfStack = ( StackType_t * ) pxSharedStackTopEDF->pxTopOfStack - 1;
                 }
                 else
                 {
-                    vTaskSwitchContext();
+                    pxTopOfStack = &( xSharedStackEDF[ configEDF_SHARED_STACK_DEPTH - 1 ] );
                 }
+
+                pxTopOfStack = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type. */
+
+                /* The jobs have nested deeper than the shared stack. */
+                configASSERT( pxTopOfStack > xSharedStackEDF );
+
+                #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+                    {
+                        pxCurrentTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, xSharedStackEDF, prvSharedStackJobEntry, ( void * ) pxCurrentTCB );
+                    }
+                #else
+                    {
+                        pxCurrentTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, prvSharedStackJobEntry, ( void * ) pxCurrentTCB );
+                    }
+                #endif
+
+                pxCurrentTCB->pxJobBelow = pxSharedStackTopEDF;
+                pxCurrentTCB->xJobOnStack = pdTRUE;
+                pxSharedStackTopEDF = pxCurrentTCB;
             }
         }
-        else
+/*-----------------------------------------------------------*/
+
+        static portTASK_FUNCTION( prvSharedStackJobEntry, pvParameters )
         {
-            mtCOVERAGE_TEST_MARKER();
+            TCB_t * const pxTCB = ( TCB_t * ) pvParameters;
+
+            for( ; ; )
+            {
+                pxTCB->pxJobCode( pxTCB->pvJobParameters );
+
+                /* Complete the job.  xTaskDelayUntil() gives its frame back,
+                 * so the context the task is switched out with is never
+                 * resumed.  The next job starts on a new frame. */
+                ( void ) xTaskDelayUntil( &( pxTCB->xJobLastWakeTime ), pxTCB->xTaskPeriod );
+            }
         }
-    }
 
-#endif /* INCLUDE_vTaskSuspend */
+    #endif /* configUSE_EDF_SHARED_STACK */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+    void vTaskGetDeadlineMissStats( TaskHandle_t xTask,
+                                    UBaseType_t * const puxMisses,
+                                    TickType_t * const pxWorstLateness )
+    {
+        TCB_t * pxTCB;
 
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+        /* If null is passed in here then we are querying the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            *puxMisses = pxTCB->uxDeadlineMisses;
+            *pxWorstLateness = pxTCB->xWorstLateness;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetEDFInfo( TaskHandle_t xTask,
+                          EDFTaskStatus_t * pxEDFStatus )
     {
-        BaseType_t xReturn = pdFALSE;
-        const TCB_t * const pxTCB = xTask;
+        TCB_t * pxTCB;
 
-        /* Accesses xPendingReadyList so must be called from a critical
-         * section. */
+        configASSERT( pxEDFStatus );
 
-        /* It does not make sense to check if the calling task is suspended. */
-        configASSERT( xTask );
+        /* If null is passed in here then we are querying the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-        /* Is the task being resumed actually in the suspended list? */
-        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        taskENTER_CRITICAL();
         {
-            /* Has the task already been resumed from within an ISR? */
-            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
-            {
-                /* Is it in the suspended list because it is in the Suspended
-                 * state, or because is is blocked with no timeout? */
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+            pxEDFStatus->xHandle = ( TaskHandle_t ) pxTCB;
+            pxEDFStatus->xPeriod = pxTCB->xTaskPeriod;
+            pxEDFStatus->xRelativeDeadline = pxTCB->xTaskRelativeDeadline;
+            pxEDFStatus->xAbsoluteDeadline = pxTCB->xAbsoluteDeadline;
+            pxEDFStatus->xReleaseTime = pxTCB->xTaskReleaseTime;
+            pxEDFStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+            pxEDFStatus->xWorstLateness = pxTCB->xWorstLateness;
+            pxEDFStatus->ulBudgetRemaining = 0UL;
+
+            #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
                 {
-                    xReturn = pdTRUE;
+                    uint32_t ulUsed = pxTCB->ulBudgetUsed;
+
+                    /* The running task has not been charged since the last
+                     * tick or context switch. */
+                    if( pxTCB == pxCurrentTCB )
+                    {
+                        ulUsed += configEDF_CLOCK() - ulBudgetChargedTime;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( ulUsed < pxTCB->ulBudget )
+                    {
+                        pxEDFStatus->ulBudgetRemaining = pxTCB->ulBudget - ulUsed;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+            #endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+        UBaseType_t uxTaskGetEDFSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                             EDFTaskStatus_t * const pxEDFStatusArray,
+                                             const UBaseType_t uxArraySize,
+                                             configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+        {
+            UBaseType_t uxTask, x;
+
+            configASSERT( pxEDFStatusArray );
+
+            /* uxTaskGetSystemState() suspends the scheduler too.  Keeping it
+             * suspended until the EDF state is read makes the two arrays one
+             * snapshot. */
+            vTaskSuspendAll();
+            {
+                uxTask = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
+
+                for( x = 0; x < uxTask; x++ )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    vTaskGetEDFInfo( pxTaskStatusArray[ x ].xHandle, &( pxEDFStatusArray[ x ] ) );
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+            ( void ) xTaskResumeAll();
 
-        return xReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+            return uxTask;
+        }
 
-#endif /* INCLUDE_vTaskSuspend */
+    #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+    uint32_t ulTaskGetEDFDensity( void )
+    {
+        /* A 32-bit read is atomic on the supported ports. */
+        return ulTotalDensityEDF;
+    }
+/*-----------------------------------------------------------*/
 
-    void vTaskResume( TaskHandle_t xTaskToResume )
+    TickType_t xTaskGetAbsoluteDeadline( TaskHandle_t xTask )
     {
-        TCB_t * const pxTCB = xTaskToResume;
+        TCB_t * pxTCB;
 
-        /* It does not make sense to resume the calling task. */
-        configASSERT( xTaskToResume );
+        /* If null is passed in here then we are querying the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-        /* The parameter cannot be NULL as it is impossible to resume the
-         * currently executing task. */
-        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+        /* A TickType_t read is atomic on the supported ports. */
+        return pxTCB->xAbsoluteDeadline;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_EXECUTION_TIME == 1 )
+
+        uint32_t ulTaskGetExecutionTime( TaskHandle_t xTask )
         {
+            TCB_t * pxTCB;
+            uint32_t ulTime;
+
+            /* If null is passed in here then we are querying the calling task. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
             taskENTER_CRITICAL();
             {
-                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
-                {
-                    traceTASK_RESUME( pxTCB );
-
-                    /* The ready list can be accessed even if the scheduler is
-                     * suspended because this is inside a critical section. */
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                ulTime = pxTCB->ulExecutionTime;
 
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                if( pxTCB == pxCurrentTCB )
+                {
+                    ulTime += configEDF_CLOCK() - pxTCB->ulSwitchedInTime;
                 }
                 else
                 {
@@ -2044,1852 +3058,3979 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             taskEXIT_CRITICAL();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
 
-#endif /* INCLUDE_vTaskSuspend */
+            return ulTime;
+        }
 
+    #endif /* configUSE_EDF_EXECUTION_TIME */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
-
-    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
-    {
-        BaseType_t xYieldRequired = pdFALSE;
-        TCB_t * const pxTCB = xTaskToResume;
-        UBaseType_t uxSavedInterruptStatus;
+    #if ( configUSE_EDF_EXECUTION_TIME == 1 )
 
-        configASSERT( xTaskToResume );
+        uint32_t ulTaskGetCPULoad( void )
+        {
+            TCB_t * const pxIdleTCB = xIdleTaskHandle;
+            uint32_t ulNow;
+            uint32_t ulElapsed;
+            uint32_t ulIdleTime;
+            uint32_t ulLoad = 0UL;
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+            configASSERT( pxIdleTCB != NULL );
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            /* Read the clock and the idle time together so the idle time
+             * cannot be later than the elapsed time. */
+            taskENTER_CRITICAL();
             {
-                traceTASK_RESUME_FROM_ISR( pxTCB );
+                ulNow = configEDF_CLOCK();
+                ulElapsed = ulNow - ulExecutionTimeStart;
+                ulIdleTime = pxIdleTCB->ulExecutionTime;
 
-                /* Check the ready lists can be accessed. */
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                if( pxIdleTCB == pxCurrentTCB )
                 {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldRequired = pdTRUE;
-
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    ulIdleTime += ulNow - pxIdleTCB->ulSwitchedInTime;
                 }
                 else
                 {
-                    /* The delayed or ready lists cannot be accessed so the task
-                     * is held in the pending ready list until the scheduler is
-                     * unsuspended. */
-                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
+            taskEXIT_CRITICAL();
+
+            if( ( ulElapsed != 0UL ) && ( ulIdleTime < ulElapsed ) )
+            {
+                /* 64-bit so the product cannot overflow, the division only
+                 * happens here and never on a context switch. */
+                ulLoad = ( uint32_t ) ( ( ( uint64_t ) ( ulElapsed - ulIdleTime ) * 100ULL ) / ( uint64_t ) ulElapsed );
+            }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xYieldRequired;
-    }
+            return ulLoad;
+        }
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+    #endif /* configUSE_EDF_EXECUTION_TIME */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+    #if ( configUSE_EDF_LOAD_WINDOW == 1 )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        static void prvLoadWindowTick( const TickType_t xTickNow )
         {
-            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-            StackType_t * pxIdleTaskStackBuffer = NULL;
-            uint32_t ulIdleTaskStackSize;
-
-            /* The Idle task is created using user provided RAM - obtain the
-             * address of the RAM then create the idle task. */
-            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                                 configIDLE_TASK_NAME,
-                                                 ulIdleTaskStackSize,
-                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                                 pxIdleTaskStackBuffer,
-                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+            TCB_t * const pxIdleTCB = xIdleTaskHandle;
+            configRUN_TIME_COUNTER_TYPE ulNow;
+            configRUN_TIME_COUNTER_TYPE ulIdleTime;
+            configRUN_TIME_COUNTER_TYPE ulElapsed;
+            configRUN_TIME_COUNTER_TYPE ulIdleInWindow;
+            uint32_t ulLoad = 0UL;
 
-            if( xIdleTaskHandle != NULL )
+            if( ( TickType_t ) ( xTickNow - xLoadWindowStart ) >= ( TickType_t ) configEDF_LOAD_WINDOW_TICKS )
             {
-                xReturn = pdPASS;
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+                #else
+                    ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* The run time of the idle task only includes its current
+                 * slice once it is switched out. */
+                ulIdleTime = pxIdleTCB->ulRunTimeCounter;
+
+                if( pxIdleTCB == pxCurrentTCB )
+                {
+                    ulIdleTime += ulNow - ulTaskSwitchedInTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulElapsed = ulNow - ulLoadWindowStartTime;
+                ulIdleInWindow = ulIdleTime - ulLoadWindowStartIdle;
+
+                if( ( ulElapsed != 0UL ) && ( ulIdleInWindow < ulElapsed ) )
+                {
+                    /* One division per window, never on a context switch. */
+                    ulLoad = ( uint32_t ) ( ( ( uint64_t ) ( ulElapsed - ulIdleInWindow ) * 100ULL ) / ( uint64_t ) ulElapsed );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xLoadWindowStart = xTickNow;
+                ulLoadWindowStartTime = ulNow;
+                ulLoadWindowStartIdle = ulIdleTime;
+                ulLoadWindow = ulLoad;
+
+                /* The sum holds the average times 2^configEDF_LOAD_EWMA_SHIFT,
+                 * so each window only costs a shift and an add. */
+                if( xLoadWindowDone != pdFALSE )
+                {
+                    ulLoadAverageSum = ulLoadAverageSum - ( ulLoadAverageSum >> configEDF_LOAD_EWMA_SHIFT ) + ulLoad;
+                }
+                else
+                {
+                    ulLoadAverageSum = ulLoad << configEDF_LOAD_EWMA_SHIFT;
+                    xLoadWindowDone = pdTRUE;
+                }
+
+                #if ( configUSE_LOAD_WINDOW_HOOK == 1 )
+                    {
+                        vApplicationLoadWindowHook( ulLoad, ulLoadAverageSum >> configEDF_LOAD_EWMA_SHIFT );
+                    }
+                #endif
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+        uint32_t ulTaskGetWindowCPULoad( void )
         {
-            /* The Idle task is being created using dynamically allocated RAM. */
-		#if (configUSE_EDF_SCHEDULER == 0)
-            xReturn = xTaskCreate( prvIdleTask,
-                                   configIDLE_TASK_NAME,
-                                   configMINIMAL_STACK_SIZE,
-                                   ( void * ) NULL,
-                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-							
-		#else 	
-						/********************************************************************************************
-						 ******** EDF modification: Creating Idle Task using xTaskPeriodicCreate function ***********
-						 ********************************************************************************************/
-					
-						TickType_t initIDLEPeriod = 300;
-						xReturn = xTaskPeriodicCreate( prvIdleTask,
-																					"IDLE",
-																						configMINIMAL_STACK_SIZE,
-																						(void * ) NULL, 
-																						( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
-																						&xIdleTaskHandle,
-																						initIDLEPeriod );
-	#endif
+            /* A 32-bit read is atomic on the supported ports. */
+            return ulLoadWindow;
         }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
+        uint32_t ulTaskGetAverageCPULoad( void )
         {
-            if( xReturn == pdPASS )
+            return ulLoadAverageSum >> configEDF_LOAD_EWMA_SHIFT;
+        }
+
+    #endif /* configUSE_EDF_LOAD_WINDOW */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_TRACE_RECORDER == 1 )
+
+        void vTaskTraceRecord( uint8_t ucEvent,
+                               struct tskTaskControlBlock * xTask,
+                               uint16_t usData )
+        {
+            const TCB_t * const pxTCB = ( xTask != NULL ) ? xTask : pxCurrentTCB;
+            const uint32_t ulHead = ulTraceHeadEDF;
+            volatile EDFTraceEvent_t * const pxEvent = &( xTraceBufferEDF[ ulHead & ( uint32_t ) ( configEDF_TRACE_BUFFER_LENGTH - 1 ) ] );
+
+            pxEvent->ulTimestamp = configEDF_CLOCK();
+            pxEvent->usData = usData;
+            pxEvent->ucEvent = ucEvent;
+            pxEvent->ucTask = ( pxTCB != NULL ) ? ( uint8_t ) pxTCB->uxTCBNumber : ( uint8_t ) 0U;
+
+            /* The reader only copies events below the head, so the head moves
+             * on once the event is complete.  The buffer is volatile so the
+             * stores cannot be reordered after this one. */
+            ulTraceHeadEDF = ulHead + 1UL;
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t uxTaskTraceRead( EDFTraceEvent_t * const pxEvents,
+                                     UBaseType_t uxMaxEvents,
+                                     uint32_t * const pulLost )
+        {
+            const uint32_t ulLength = ( uint32_t ) configEDF_TRACE_BUFFER_LENGTH;
+            uint32_t ulHead = ulTraceHeadEDF;
+            uint32_t ulTail = ulTraceTailEDF;
+            uint32_t ulLost = 0UL;
+            uint32_t ulOverwritten;
+            UBaseType_t uxCount, x;
+
+            /* Only the last ulLength events are still in the buffer.  The
+             * counts are compared by difference, so they may wrap. */
+            if( ( ulHead - ulTail ) > ulLength )
             {
-                xReturn = xTimerCreateTimerTask();
+                ulLost = ( ulHead - ulTail ) - ulLength;
+                ulTail = ulHead - ulLength;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-    #endif /* configUSE_TIMERS */
 
-    if( xReturn == pdPASS )
-    {
-        /* freertos_tasks_c_additions_init() should only be called if the user
-         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
-         * the only macro called by the function. */
-        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+            uxCount = ( UBaseType_t ) ( ulHead - ulTail );
+
+            if( uxCount > uxMaxEvents )
             {
-                freertos_tasks_c_additions_init();
+                uxCount = uxMaxEvents;
             }
-        #endif
-
-        /* Interrupts are turned off here, to ensure a tick does not occur
-         * before or during the call to xPortStartScheduler().  The stacks of
-         * the created tasks contain a status word with interrupts switched on
-         * so interrupts will automatically get re-enabled when the first task
-         * starts to run. */
-        portDISABLE_INTERRUPTS();
-
-        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            else
             {
-                /* Switch Newlib's _impure_ptr variable to point to the _reent
-                 * structure specific to the task that will run first.
-                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-                 * for additional information. */
-                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif /* configUSE_NEWLIB_REENTRANT */
 
-        xNextTaskUnblockTime = portMAX_DELAY;
-        xSchedulerRunning = pdTRUE;
-        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-
-        /* If configGENERATE_RUN_TIME_STATS is defined then the following
-         * macro must be defined to configure the timer/counter used to generate
-         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
-         * is set to 0 and the following line fails to build then ensure you do not
-         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
-         * FreeRTOSConfig.h file. */
-        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+            for( x = 0; x < uxCount; x++ )
+            {
+                pxEvents[ x ] = xTraceBufferEDF[ ( ulTail + ( uint32_t ) x ) & ( ulLength - 1UL ) ];
+            }
 
-        traceTASK_SWITCHED_IN();
+            /* The recorder is not stopped, and always runs to completion
+             * before this task runs again.  Event n was overwritten during
+             * the copy if the head has since passed n + ulLength. */
+            ulHead = ulTraceHeadEDF;
 
-        /* Setting up the timer tick is hardware specific and thus in the
-         * portable interface. */
-        if( xPortStartScheduler() != pdFALSE )
-        {
-            /* Should not reach here as if the scheduler is running the
-             * function will not return. */
-        }
-        else
-        {
-            /* Should only reach here if a task calls xTaskEndScheduler(). */
-        }
-    }
-    else
-    {
-        /* This line will only be reached if the kernel could not be started,
-         * because there was not enough FreeRTOS heap to create the idle task
-         * or the timer task. */
-        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
-    }
+            if( ( ulHead - ulTail ) > ulLength )
+            {
+                ulOverwritten = ( ulHead - ulTail ) - ulLength;
 
-    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+                if( ulOverwritten > ( uint32_t ) uxCount )
+                {
+                    ulOverwritten = ( uint32_t ) uxCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
-     * from getting optimized out as it is no longer used by the kernel. */
-    ( void ) uxTopUsedPriority;
-}
-/*-----------------------------------------------------------*/
+                uxCount -= ( UBaseType_t ) ulOverwritten;
+                ( void ) memmove( pxEvents, &( pxEvents[ ulOverwritten ] ), ( size_t ) uxCount * sizeof( EDFTraceEvent_t ) );
+                ulLost += ulOverwritten;
+                ulTail += ulOverwritten;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-void vTaskEndScheduler( void )
-{
-    /* Stop the scheduler interrupts and call the portable scheduler end
-     * routine so the original ISRs can be restored if necessary.  The port
-     * layer must ensure interrupts enable  bit is left in the correct state. */
-    portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
-    vPortEndScheduler();
-}
-/*----------------------------------------------------------*/
+            ulTraceTailEDF = ulTail + ( uint32_t ) uxCount;
 
-void vTaskSuspendAll( void )
-{
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
+            if( pulLost != NULL )
+            {
+                *pulLost = ulLost;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
+            return uxCount;
+        }
 
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+    #endif /* configUSE_EDF_TRACE_RECORDER */
 
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    static TickType_t prvGetExpectedIdleTime( void )
+    void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
-        TickType_t xReturn;
-        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+        TCB_t * pxTCB;
 
-        /* uxHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
-            {
-                if( uxTopReadyPriority > tskIDLE_PRIORITY )
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the calling task that is
+             * being deleted. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+
+            #if ( configUSE_EDF_SHARED_STACK == 1 )
                 {
-                    uxHigherPriorityReadyTasks = pdTRUE;
+                    /* A job can only be deleted between two jobs, when it has
+                     * no frame on the shared stack. */
+                    configASSERT( pxTCB->xJobOnStack == pdFALSE );
                 }
+            #endif
+
+            /* Remove task from the ready/delayed list. */
+            if( prvRemoveTaskFromStateList( pxTCB ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
             }
-        #else
+            else
             {
-                const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                /* When port optimised task selection is used the uxTopReadyPriority
-                 * variable is used as a bit map.  If bits other than the least
-                 * significant bit are set then there are tasks that have a priority
-                 * above the idle priority that are in the Ready state.  This takes
-                 * care of the case where the co-operative scheduler is in use. */
-                if( uxTopReadyPriority > uxLeastSignificantBit )
-                {
-                    uxHigherPriorityReadyTasks = pdTRUE;
-                }
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
-        {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
-        }
-        else if( uxHigherPriorityReadyTasks != pdFALSE )
-        {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
-            xReturn = 0;
-        }
-        else
-        {
-            xReturn = xNextTaskUnblockTime - xTickCount;
-        }
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The processor share of the task is free for new tasks.
+                     * Already in a critical section. */
+                    ulTotalDensityEDF -= pxTCB->ulTaskDensity;
+                }
+            #endif
 
-        return xReturn;
-    }
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+            if( pxTCB == pxCurrentTCB )
+            {
+                /* A task is deleting itself.  This cannot complete within the
+                 * task itself, as a context switch to another task is required.
+                 * Place the task in the termination list.  The idle task will
+                 * check the termination list and free up any memory allocated by
+                 * the scheduler for the TCB and stack of the deleted task. */
+                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
-BaseType_t xTaskResumeAll( void )
-{
-    TCB_t * pxTCB = NULL;
-    BaseType_t xAlreadyYielded = pdFALSE;
+                /* Increment the ucTasksDeleted variable so the idle task knows
+                 * there is a task that has been deleted and that it should therefore
+                 * check the xTasksWaitingTermination list. */
+                ++uxDeletedTasksWaitingCleanUp;
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
+                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
+                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
+                traceTASK_DELETE( pxTCB );
 
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
-    {
-        --uxSchedulerSuspended;
+                /* The pre-delete hook is primarily for the Windows simulator,
+                 * in which Windows specific clean up operations are performed,
+                 * after which it is not possible to yield away from this task -
+                 * hence xYieldPending is used to latch that a context switch is
+                 * required. */
+                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+            }
+            else
+            {
+                --uxCurrentNumberOfTasks;
+                traceTASK_DELETE( pxTCB );
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                /* Reset the next expected unblock time in case it referred to
+                 * the task that has just been deleted. */
+                prvResetNextTaskUnblockTime();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* If the task is not deleting itself, call prvDeleteTCB from outside of
+         * critical section. If a task deletes itself, prvDeleteTCB is called
+         * from prvCheckTasksWaitingTermination which is called from Idle task. */
+        if( pxTCB != pxCurrentTCB )
         {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            prvDeleteTCB( pxTCB );
+        }
+
+        /* Force a reschedule if it is the currently running task that has just
+         * been deleted. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxTCB == pxCurrentTCB )
             {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
-                {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
 
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskDelayUntil == 1 )
+
+    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                const TickType_t xTimeIncrement )
+    {
+        TickType_t xTimeToWake;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
+
+        configASSERT( pxPreviousWakeTime );
+        configASSERT( ( xTimeIncrement > 0U ) );
+        configASSERT( uxSchedulerSuspended == 0 );
+
+        vTaskSuspendAll();
+        {
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = xTickCount;
+
+            /* Generate the tick time at which the task wants to wake. */
+            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+            #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+                {
+                    /* Jobs given up by the budget overrun policy are not
+                     * released. */
+                    xTimeToWake += xTimeIncrement * ( TickType_t ) pxCurrentTCB->uxJobsToSkip;
                 }
+            #endif
 
-                if( pxTCB != NULL )
+            if( xConstTickCount < *pxPreviousWakeTime )
+            {
+                /* The tick count has overflowed since this function was
+                 * lasted called.  In this case the only time we should ever
+                 * actually delay is if the wake time has also  overflowed,
+                 * and the wake time is greater than the tick time.  When this
+                 * is the case it is as if neither time had overflowed. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
                 {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                /* The tick time has not overflowed.  In this case we will
+                 * delay if either the wake time has overflowed, and/or the
+                 * tick time is less than the wake time. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                {
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
+            /* Update the wake time ready for the next call. */
+            *pxPreviousWakeTime = xTimeToWake;
+
+            #if ( configUSE_EDF_SCHEDULER == 1 )
                 {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+                    /* The calling task has completed its job.  Account for it
+                     * being late before the next job is released exactly one
+                     * period after the last one. */
+                    prvRecordJobCompletion( pxCurrentTCB, xConstTickCount );
 
-                    if( xPendedCounts > ( TickType_t ) 0U )
-                    {
-                        do
+                    #if ( configUSE_EDF_SHARED_STACK == 1 )
                         {
-                            if( xTaskIncrementTick() != pdFALSE )
+                            /* A job on the shared stack gives its frame back.
+                             * The scheduler is suspended, so no job can be
+                             * placed on it before this one is switched out. */
+                            if( pxCurrentTCB->xJobOnStack != pdFALSE )
                             {
-                                xYieldPending = pdTRUE;
+                                configASSERT( pxSharedStackTopEDF == pxCurrentTCB );
+                                pxSharedStackTopEDF = pxCurrentTCB->pxJobBelow;
+                                pxCurrentTCB->pxJobBelow = NULL;
+                                pxCurrentTCB->xJobOnStack = pdFALSE;
                             }
                             else
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
+                        }
+                    #endif
 
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
-
-                        xPendedTicks = 0;
+                    if( pxCurrentTCB->xTaskPeriod != ( TickType_t ) 0U )
+                    {
+                        pxCurrentTCB->xTaskReleaseTime += pxCurrentTCB->xTaskPeriod;
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        pxCurrentTCB->xTaskReleaseTime = xTimeToWake;
                     }
-                }
 
-                if( xYieldPending != pdFALSE )
-                {
-                    #if ( configUSE_PREEMPTION != 0 )
+                    #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
                         {
-                            xAlreadyYielded = pdTRUE;
+                            /* Demoted and throttled jobs already moved the
+                             * release on when they took over a slot. */
+                            if( pxCurrentTCB->eBudgetPolicy == eBudgetSkipNextJob )
+                            {
+                                pxCurrentTCB->xTaskReleaseTime += pxCurrentTCB->xTaskPeriod * ( TickType_t ) pxCurrentTCB->uxJobsToSkip;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            /* The next job starts with a full budget.  The
+                             * scheduler is suspended so the tick cannot charge
+                             * the task meanwhile. */
+                            pxCurrentTCB->uxJobsToSkip = ( UBaseType_t ) 0U;
+                            pxCurrentTCB->ulBudgetUsed = 0UL;
+                            pxCurrentTCB->xBudgetExceeded = pdFALSE;
+                            ulBudgetChargedTime = configEDF_CLOCK();
                         }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    #endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
                 }
+            #endif /* configUSE_EDF_SCHEDULER */
+
+            if( xShouldDelay != pdFALSE )
+            {
+                traceTASK_DELAY_UNTIL( xTimeToWake );
+
+                /* prvAddCurrentTaskToDelayedList() needs the block time, not
+                 * the time to wake, so subtract the current tick count. */
+                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+            }
+            else
+            {
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* The next job was already released, so it starts
+                         * straight away.  Move the task to the position of
+                         * its new deadline in the ready queue. */
+                        ( void ) prvRemoveTaskFromStateList( pxCurrentTCB );
+                        prvAddTaskToReadyList( pxCurrentTCB );
+                    }
+                #else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #endif /* configUSE_EDF_SCHEDULER */
             }
         }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xShouldDelay;
     }
-    taskEXIT_CRITICAL();
 
-    return xAlreadyYielded;
-}
+#endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-TickType_t xTaskGetTickCount( void )
-{
-    TickType_t xTicks;
+#if ( INCLUDE_vTaskDelay == 1 )
 
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
+    void vTaskDelay( const TickType_t xTicksToDelay )
     {
-        xTicks = xTickCount;
-    }
-    portTICK_TYPE_EXIT_CRITICAL();
+        BaseType_t xAlreadyYielded = pdFALSE;
 
-    return xTicks;
-}
-/*-----------------------------------------------------------*/
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
+        {
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
+            {
+                traceTASK_DELAY();
 
-TickType_t xTaskGetTickCountFromISR( void )
-{
-    TickType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* Periodic tasks complete their jobs by calling
+                         * vTaskDelayUntil(), so a plain delay does not move
+                         * their release.  A task without a period is
+                         * released again when it wakes, unless a CBS sets
+                         * its deadline. */
+                        if( ( pxCurrentTCB->xTaskPeriod == ( TickType_t ) 0U ) &&
+                            ( taskEDF_CBS_BUDGET( pxCurrentTCB ) == ( TickType_t ) 0U ) )
+                        {
+                            pxCurrentTCB->xTaskReleaseTime = xTickCount + xTicksToDelay;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif /* configUSE_EDF_SCHEDULER */
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
-    {
-        xReturn = xTickCount;
-    }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxTaskGetNumberOfTasks( void )
-{
-    /* A critical section is not required because the variables are of type
-     * BaseType_t. */
-    return uxCurrentNumberOfTasks;
-}
-/*-----------------------------------------------------------*/
-
-char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-    TCB_t * pxTCB;
-
-    /* If null is passed in here then the name of the calling task is being
-     * queried. */
-    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-    configASSERT( pxTCB );
-    return &( pxTCB->pcTaskName[ 0 ] );
-}
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] )
-    {
-        TCB_t * pxNextTCB, * pxFirstTCB, * pxReturn = NULL;
-        UBaseType_t x;
-        char cNextChar;
-        BaseType_t xBreakLoop;
-
-        /* This function is called with the scheduler suspended. */
-
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-                /* Check each character in the name looking for a match or
-                 * mismatch. */
-                xBreakLoop = pdFALSE;
-
-                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
-                {
-                    cNextChar = pxNextTCB->pcTaskName[ x ];
-
-                    if( cNextChar != pcNameToQuery[ x ] )
-                    {
-                        /* Characters didn't match. */
-                        xBreakLoop = pdTRUE;
-                    }
-                    else if( cNextChar == ( char ) 0x00 )
-                    {
-                        /* Both strings terminated, a match must have been
-                         * found. */
-                        pxReturn = pxNextTCB;
-                        xBreakLoop = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    if( xBreakLoop != pdFALSE )
-                    {
-                        break;
-                    }
-                }
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                if( pxReturn != NULL )
-                {
-                    /* The handle has been found. */
-                    break;
-                }
-            } while( pxNextTCB != pxFirstTCB );
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        return pxReturn;
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
-    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    eTaskState eTaskGetState( TaskHandle_t xTask )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
-        TCB_t * pxTCB;
+        eTaskState eReturn;
+        List_t const * pxStateList, * pxDelayedList, * pxOverflowedDelayedList;
+        const TCB_t * const pxTCB = xTask;
 
-        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
-        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+        configASSERT( pxTCB );
 
-        vTaskSuspendAll();
+        if( pxTCB == pxCurrentTCB )
         {
-            /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
-
-                if( pxTCB != NULL )
-                {
-                    /* Found the handle. */
-                    break;
-                }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            /* The task calling this function is querying its own state. */
+            eReturn = eRunning;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                pxDelayedList = pxDelayedTaskList;
+                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
             }
+            taskEXIT_CRITICAL();
 
-            if( pxTCB == NULL )
+            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
             }
 
+            #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+                else if( taskEDF_IN_TIMING_WHEEL( pxStateList ) )
+                {
+                    /* The delayed tasks are in the timing wheel instead. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
                 {
-                    if( pxTCB == NULL )
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
                     {
-                        /* Search the suspended list. */
-                        pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                            {
+                                BaseType_t x;
+
+                                /* The task does not appear on the event list item of
+                                 * and of the RTOS objects, but could still be in the
+                                 * blocked state if it is waiting on its notification
+                                 * rather than waiting on an object.  If not, is
+                                 * suspended. */
+                                eReturn = eSuspended;
+
+                                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                                {
+                                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                                    {
+                                        eReturn = eBlocked;
+                                        break;
+                                    }
+                                }
+                            }
+                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                            {
+                                eReturn = eSuspended;
+                            }
+                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                    }
+                    else
+                    {
+                        eReturn = eBlocked;
                     }
                 }
-            #endif
+            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
 
             #if ( INCLUDE_vTaskDelete == 1 )
+                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
                 {
-                    if( pxTCB == NULL )
-                    {
-                        /* Search the deleted list. */
-                        pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
-                    }
+                    /* The task being queried is referenced from the deleted
+                     * tasks list, or it is not referenced from any lists at
+                     * all. */
+                    eReturn = eDeleted;
                 }
             #endif
+
+            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+            {
+                /* If the task is not in any other state, it must be in the
+                 * Ready (including pending ready) state. */
+                eReturn = eReady;
+            }
         }
-        ( void ) xTaskResumeAll();
 
-        return pxTCB;
-    }
+        return eReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* INCLUDE_eTaskGetState */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
 
-    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
-                                      const UBaseType_t uxArraySize,
-                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
     {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
 
-        vTaskSuspendAll();
+        taskENTER_CRITICAL();
         {
-            /* Is there a space in the array for each task in the system? */
-            if( uxArraySize >= uxCurrentNumberOfTasks )
-            {
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Ready state. */
-                do
-                {
-                    uxQueue--;
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
-                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            /* If null is passed in here then it is the priority of the task
+             * that called uxTaskPriorityGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        taskEXIT_CRITICAL();
 
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
-
-                #if ( INCLUDE_vTaskDelete == 1 )
-                    {
-                        /* Fill in an TaskStatus_t structure with information on
-                         * each task that has been deleted but not yet cleaned up. */
-                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
-                    }
-                #endif
-
-                #if ( INCLUDE_vTaskSuspend == 1 )
-                    {
-                        /* Fill in an TaskStatus_t structure with information on
-                         * each task in the Suspended state. */
-                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
-                    }
-                #endif
-
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
-                    {
-                        if( pulTotalRunTime != NULL )
-                        {
-                            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                                portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                            #else
-                                *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                            #endif
-                        }
-                    }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
-                    {
-                        if( pulTotalRunTime != NULL )
-                        {
-                            *pulTotalRunTime = 0;
-                        }
-                    }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        ( void ) xTaskResumeAll();
-
-        return uxTask;
+        return uxReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
-    }
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn, uxSavedInterruptState;
 
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
 
-    void vTaskStepTick( const TickType_t xTicksToJump )
-    {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
+        return uxReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
+#if ( INCLUDE_vTaskPrioritySet == 1 )
 
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    void vTaskPrioritySet( TaskHandle_t xTask,
+                           UBaseType_t uxNewPriority )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
+        BaseType_t xYieldRequired = pdFALSE;
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
-    xPendedTicks += xTicksToCatchUp;
-    xYieldOccurred = xTaskResumeAll();
+        configASSERT( uxNewPriority < configMAX_PRIORITIES );
 
-    return xYieldOccurred;
-}
-/*----------------------------------------------------------*/
+        /* Ensure the new priority is valid. */
+        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
+            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
 
-        configASSERT( pxTCB );
+            #if ( configUSE_MUTEXES == 1 )
+                {
+                    uxCurrentBasePriority = pxTCB->uxBasePriority;
+                }
+            #else
+                {
+                    uxCurrentBasePriority = pxTCB->uxPriority;
+                }
+            #endif
 
-        vTaskSuspendAll();
-        {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+            if( uxCurrentBasePriority != uxNewPriority )
             {
-                xReturn = pdPASS;
-
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
+                /* The priority change may have readied a task of higher
+                 * priority than the calling task. */
+                if( uxNewPriority > uxCurrentBasePriority )
                 {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    if( pxTCB != pxCurrentTCB )
                     {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
+                        /* The priority of a task other than the currently
+                         * running task is being raised.  Is the priority being
+                         * raised above that of the running task? */
+                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The priority of the running task is being raised,
+                         * but the running task must already be the highest
+                         * priority task able to run so no yield is required. */
                     }
                 }
-                taskEXIT_CRITICAL();
+                else if( pxTCB == pxCurrentTCB )
+                {
+                    /* Setting the priority of the running task down means
+                     * there may now be another task of higher priority that
+                     * is ready to execute. */
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    /* Setting the priority of any other task down does not
+                     * require a yield as the running task must be above the
+                     * new priority of the task being modified. */
+                }
 
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
+                /* Remember the ready list the task might be referenced from
+                 * before its uxPriority member is changed so the
+                 * taskRESET_READY_PRIORITY() macro can function correctly. */
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
 
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                #if ( configUSE_MUTEXES == 1 )
                     {
-                        /* Preemption is on, but a context switch should only be
-                         * performed if the unblocked task has a priority that is
-                         * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        /* Only change the priority being used if the task is not
+                         * currently using an inherited priority. */
+                        if( pxTCB->uxBasePriority == pxTCB->uxPriority )
                         {
-                            /* Pend the yield to be performed when the scheduler
-                             * is unsuspended. */
-                            xYieldPending = pdTRUE;
+                            pxTCB->uxPriority = uxNewPriority;
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                #endif /* configUSE_PREEMPTION */
-            }
-            else
-            {
-                xReturn = pdFAIL;
-            }
-        }
-        ( void ) xTaskResumeAll();
 
-        return xReturn;
-    }
+                        /* The base priority gets set whatever. */
+                        pxTCB->uxBasePriority = uxNewPriority;
+                    }
+                #else /* if ( configUSE_MUTEXES == 1 ) */
+                    {
+                        pxTCB->uxPriority = uxNewPriority;
+                    }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
-
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
-
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-    {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
-
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
-
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-        {
-            taskSWITCH_DELAYED_LISTS();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
-        {
-            for( ; ; )
-            {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                    if( xConstTickCount < xItemValue )
+                /* If the task is in the blocked or suspended list we need do
+                 * nothing more than change its priority variable. However, if
+                 * the task is in a ready list it needs to be removed and placed
+                 * in the list appropriate to its new priority. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    /* The task is currently in its ready list - remove before
+                     * adding it to its new ready list.  As we are in a critical
+                     * section we can do this even if the scheduler is suspended. */
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-										
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-										
-/********************************************************************************
- ***********	 EDF modification: Calculate new deadline of the task	 ************
- ********************************************************************************/
-																		
-									#if (configUSE_EDF_SCHEDULER == 1)
-										listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB)->xTaskPeriod +   xTaskGetTickCount());
-									#endif
-										
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
                     prvAddTaskToReadyList( pxTCB );
-				
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                        {
-                            /* Preemption is on, but a context switch should
-                             * only be performed if the unblocked task has a
-                             * priority that is equal to or higher than the
-                             * currently executing task. */
-													#if (configUSE_EDF_SCHEDULER == 0)
-                            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-													#else
-													
-					/*******************************************************************************************************************************
-					 ***********	 EDF modification: invoke switch context API if deadline of the unblocked task is closer than current ************
-					 *******************************************************************************************************************************/
-														if( listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) ) < listGET_LIST_ITEM_VALUE( &( ( pxCurrentTCB )->xStateListItem ) ) )
-													#endif
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                    #endif /* configUSE_PREEMPTION */
-                }
-            }
-        }
-
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
-            {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
-                {
-                    xSwitchRequired = pdTRUE;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
-        #if ( configUSE_TICK_HOOK == 1 )
-            {
-                /* Guard against the tick hook being called when the pended tick
-                 * count is being unwound (when the scheduler is being unlocked). */
-                if( xPendedTicks == ( TickType_t ) 0 )
+                if( xYieldRequired != pdFALSE )
                 {
-                    vApplicationTickHook();
+                    taskYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
             }
-        #endif /* configUSE_TICK_HOOK */
+        }
+        taskEXIT_CRITICAL();
+    }
 
-        #if ( configUSE_PREEMPTION == 1 )
-            {
-                if( xYieldPending != pdFALSE )
-                {
-                    xSwitchRequired = pdTRUE;
-                }
-                else
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+            #if ( configUSE_EDF_SHARED_STACK == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Likewise a job is only suspended between two jobs. */
+                    configASSERT( pxTCB->xJobOnStack == pdFALSE );
                 }
+            #endif
+
+            traceTASK_SUSPEND( pxTCB );
+
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            if( prvRemoveTaskFromStateList( pxTCB ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif /* configUSE_PREEMPTION */
-    }
-    else
-    {
-        ++xPendedTicks;
 
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                vApplicationTickHook();
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif
-    }
 
-    return xSwitchRequired;
-}
-/*-----------------------------------------------------------*/
+            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                {
+                    BaseType_t x;
 
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
-    {
-        TCB_t * xTCB;
+                    for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                    {
+                        if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                        {
+                            /* The task was blocked to wait for a notification, but is
+                             * now suspended, so no notification was received. */
+                            pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                        }
+                    }
+                }
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+        }
+        taskEXIT_CRITICAL();
 
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
+        if( xSchedulerRunning != pdFALSE )
         {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
+            taskENTER_CRITICAL();
+            {
+                prvResetNextTaskUnblockTime();
+            }
+            taskEXIT_CRITICAL();
         }
         else
         {
-            xTCB = xTask;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
+        if( pxTCB == pxCurrentTCB )
         {
-            xTCB->pxTaskTag = pxHookFunction;
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* The current task has just been suspended. */
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                /* The scheduler is not running, but the task that was pointed
+                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                 * must be adjusted to point to a different task. */
+                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                {
+                    /* No other tasks are ready, so set pxCurrentTCB back to
+                     * NULL so when the next task is created pxCurrentTCB will
+                     * be set to point to it no matter what its relative priority
+                     * is. */
+                    pxCurrentTCB = NULL;
+                }
+                else
+                {
+                    vTaskSwitchContext();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const TCB_t * const pxTCB = xTask;
+
+        /* Accesses xPendingReadyList so must be called from a critical
+         * section. */
+
+        /* It does not make sense to check if the calling task is suspended. */
+        configASSERT( xTask );
+
+        /* Is the task being resumed actually in the suspended list? */
+        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            /* Has the task already been resumed from within an ISR? */
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                /* Is it in the suspended list because it is in the Suspended
+                 * state, or because is is blocked with no timeout? */
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskResume( TaskHandle_t xTaskToResume )
+    {
+        TCB_t * const pxTCB = xTaskToResume;
+
+        /* It does not make sense to resume the calling task. */
+        configASSERT( xTaskToResume );
+
+        /* The parameter cannot be NULL as it is impossible to resume the
+         * currently executing task. */
+        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    traceTASK_RESUME( pxTCB );
+
+                    /* The ready list can be accessed even if the scheduler is
+                     * suspended because this is inside a critical section. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddWokenTaskToReadyList( pxTCB );
+
+                    /* A higher priority task may have just been resumed. */
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                    #endif
+                    {
+                        /* This yield may not cause the task just resumed to run,
+                         * but will leave the lists in the correct state for the
+                         * next yield. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        TCB_t * const pxTCB = xTaskToResume;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToResume );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            {
+                traceTASK_RESUME_FROM_ISR( pxTCB );
+
+                /* Check the ready lists can be accessed. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    /* Ready lists can be accessed so move the task from the
+                     * suspended list to the ready list directly.  The task is
+                     * compared with the running task once it is in the ready
+                     * list, where its deadline is known. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddWokenTaskToReadyList( pxTCB );
+
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                    #endif
+                    {
+                        xYieldRequired = pdTRUE;
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the return value to initiate a context switch
+                         * from the ISR using portYIELD_FROM_ISR. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The delayed or ready lists cannot be accessed so the task
+                     * is held in the pending ready list until the scheduler is
+                     * unsuspended. */
+                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xYieldRequired;
+    }
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    /* Add the idle task at the lowest priority. */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+        {
+            /* The Idle task is being created using dynamically allocated RAM.
+             * Under the EDF scheduler it is moved out of the ready queue into
+             * the background slot when the scheduler starts, see below. */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+    #if ( configUSE_TIMERS == 1 )
+        {
+            if( xReturn == pdPASS )
+            {
+                xReturn = xTimerCreateTimerTask();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* configUSE_TIMERS */
+
+    if( xReturn == pdPASS )
+    {
+        /* freertos_tasks_c_additions_init() should only be called if the user
+         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
+         * the only macro called by the function. */
+        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+            {
+                freertos_tasks_c_additions_init();
+            }
+        #endif
+
+        /* Interrupts are turned off here, to ensure a tick does not occur
+         * before or during the call to xPortStartScheduler().  The stacks of
+         * the created tasks contain a status word with interrupts switched on
+         * so interrupts will automatically get re-enabled when the first task
+         * starts to run. */
+        portDISABLE_INTERRUPTS();
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                /* The idle task was made ready like any other task when it was
+                 * created.  Move it to the background slot, which
+                 * taskSELECT_EARLIEST_DEADLINE_TASK() falls back on when the
+                 * ready queue is empty, then pick the task to run first. */
+                ( void ) prvRemoveTaskFromStateList( xIdleTaskHandle );
+                listINSERT_END( &xBackgroundListEDF, &( xIdleTaskHandle->xStateListItem ) );
+                taskSELECT_EARLIEST_DEADLINE_TASK();
+
+                #if ( configUSE_EDF_SHARED_STACK == 1 )
+                    {
+                        prvSharedStackSwitchIn();
+                    }
+                #endif
+            }
+        #endif /* configUSE_EDF_SCHEDULER */
+
+        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            {
+                /* Switch Newlib's _impure_ptr variable to point to the _reent
+                 * structure specific to the task that will run first.
+                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+                 * for additional information. */
+                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+            }
+        #endif /* configUSE_NEWLIB_REENTRANT */
+
+        xSchedulerRunning = pdTRUE;
+        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                /* Tasks created with a release offset are already waiting in
+                 * the delayed list. */
+                prvResetNextTaskUnblockTime();
+
+                #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+                    {
+                        ulBudgetChargedTime = configEDF_CLOCK();
+                    }
+                #endif
+
+                #if ( configUSE_EDF_EXECUTION_TIME == 1 )
+                    {
+                        ulExecutionTimeStart = configEDF_CLOCK();
+                        pxCurrentTCB->ulSwitchedInTime = ulExecutionTimeStart;
+                    }
+                #endif
+            }
+        #else
+            {
+                xNextTaskUnblockTime = portMAX_DELAY;
+            }
+        #endif /* configUSE_EDF_SCHEDULER */
+
+        /* If configGENERATE_RUN_TIME_STATS is defined then the following
+         * macro must be defined to configure the timer/counter used to generate
+         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
+         * is set to 0 and the following line fails to build then ensure you do not
+         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
+         * FreeRTOSConfig.h file. */
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+        #if ( configUSE_EDF_LOAD_WINDOW == 1 )
+            {
+                /* The first window starts now.  The first slice of the task
+                 * switched in is counted from here too, not from whenever the
+                 * counter started, so the idle time cannot exceed the window. */
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulLoadWindowStartTime );
+                #else
+                    ulLoadWindowStartTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                ulTaskSwitchedInTime = ulLoadWindowStartTime;
+                ulLoadWindowStartIdle = ( ( TCB_t * ) xIdleTaskHandle )->ulRunTimeCounter;
+                xLoadWindowStart = xTickCount;
+            }
+        #endif
+
+        traceTASK_SWITCHED_IN();
+
+        /* Setting up the timer tick is hardware specific and thus in the
+         * portable interface. */
+        if( xPortStartScheduler() != pdFALSE )
+        {
+            /* Should not reach here as if the scheduler is running the
+             * function will not return. */
+        }
+        else
+        {
+            /* Should only reach here if a task calls xTaskEndScheduler(). */
+        }
+    }
+    else
+    {
+        /* This line will only be reached if the kernel could not be started,
+         * because there was not enough FreeRTOS heap to create the idle task
+         * or the timer task. */
+        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+    }
+
+    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
+     * meaning xIdleTaskHandle is not used anywhere else. */
+    ( void ) xIdleTaskHandle;
+
+    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
+     * from getting optimized out as it is no longer used by the kernel. */
+    ( void ) uxTopUsedPriority;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskEndScheduler( void )
+{
+    /* Stop the scheduler interrupts and call the portable scheduler end
+     * routine so the original ISRs can be restored if necessary.  The port
+     * layer must ensure interrupts enable  bit is left in the correct state. */
+    portDISABLE_INTERRUPTS();
+    xSchedulerRunning = pdFALSE;
+    vPortEndScheduler();
+}
+/*----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    /* A critical section is not required as the variable is of type
+     * BaseType_t.  Please read Richard Barry's reply in the following link to a
+     * post in the FreeRTOS support forum before reporting this as a bug! -
+     * https://goo.gl/wu4acr */
+
+    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+     * do not otherwise exhibit real time behaviour. */
+    portSOFTWARE_BARRIER();
+
+    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+     * is used to allow calls to vTaskSuspendAll() to nest. */
+    ++uxSchedulerSuspended;
+
+    /* Enforces ordering for ports and optimised compilers that may otherwise place
+     * the above increment elsewhere. */
+    portMEMORY_BARRIER();
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void )
+    {
+        TickType_t xReturn;
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                /*******************************************************************
+                 ***********	 EDF modification: Idle until the next release	 ************
+                 *******************************************************************/
+
+                /* The idle task runs from the background slot, so the processor
+                 * is idle exactly when the ready queue is empty.  Every job that
+                 * is not ready is waiting in the delayed list for its release or
+                 * a timeout, or is suspended, so the tick can be suppressed up to
+                 * xNextTaskUnblockTime. */
+                if( ( pxCurrentTCB != xIdleTaskHandle ) || ( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE ) )
+                {
+                    xReturn = 0;
+                }
+                else
+                {
+                    #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+                        {
+                            /* The tick interrupt does not keep
+                             * xNextTaskUnblockTime up to date with the timing
+                             * wheel, so it is worked out here.  vTaskStepTick()
+                             * checks the sleep against it. */
+                            xNextTaskUnblockTime = prvTimingWheelNextEvent();
+                        }
+                    #endif
+
+                    xReturn = xNextTaskUnblockTime - xTickCount;
+                }
+            }
+        #else /* configUSE_EDF_SCHEDULER */
+            {
+                UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+                /* uxHigherPriorityReadyTasks takes care of the case where
+                 * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+                 * task that are in the Ready state, even though the idle task is
+                 * running. */
+                #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+                    {
+                        if( uxTopReadyPriority > tskIDLE_PRIORITY )
+                        {
+                            uxHigherPriorityReadyTasks = pdTRUE;
+                        }
+                    }
+                #else
+                    {
+                        const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+
+                        /* When port optimised task selection is used the uxTopReadyPriority
+                         * variable is used as a bit map.  If bits other than the least
+                         * significant bit are set then there are tasks that have a priority
+                         * above the idle priority that are in the Ready state.  This takes
+                         * care of the case where the co-operative scheduler is in use. */
+                        if( uxTopReadyPriority > uxLeastSignificantBit )
+                        {
+                            uxHigherPriorityReadyTasks = pdTRUE;
+                        }
+                    }
+                #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+
+                if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+                {
+                    xReturn = 0;
+                }
+                else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+                {
+                    /* There are other idle priority tasks in the ready state.  If
+                     * time slicing is used then the very next tick interrupt must be
+                     * processed. */
+                    xReturn = 0;
+                }
+                else if( uxHigherPriorityReadyTasks != pdFALSE )
+                {
+                    /* There are tasks in the Ready state that have a priority above the
+                     * idle priority.  This path can only be reached if
+                     * configUSE_PREEMPTION is 0. */
+                    xReturn = 0;
+                }
+                else
+                {
+                    xReturn = xNextTaskUnblockTime - xTickCount;
+                }
+            }
+        #endif /* configUSE_EDF_SCHEDULER */
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    TCB_t * pxTCB = NULL;
+    BaseType_t xAlreadyYielded = pdFALSE;
+
+    /* If uxSchedulerSuspended is zero then this function does not match a
+     * previous call to vTaskSuspendAll(). */
+    configASSERT( uxSchedulerSuspended );
+
+    /* It is possible that an ISR caused a task to be removed from an event
+     * list while the scheduler was suspended.  If this was the case then the
+     * removed task will have been added to the xPendingReadyList.  Once the
+     * scheduler has been resumed it is safe to move all the pending ready
+     * tasks from this list into their appropriate ready list. */
+    taskENTER_CRITICAL();
+    {
+        --uxSchedulerSuspended;
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            {
+                /* Move any readied tasks from the pending list into the
+                 * appropriate ready list. */
+                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    portMEMORY_BARRIER();
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddWokenTaskToReadyList( pxTCB );
+
+                    /* If the moved task has a priority higher than or equal to
+                     * the current task then a yield must be performed. */
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #else
+                        if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                    #endif
+                    {
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pxTCB != NULL )
+                {
+                    /* A task was unblocked while the scheduler was suspended,
+                     * which may have prevented the next unblock time from being
+                     * re-calculated, in which case re-calculate it now.  Mainly
+                     * important for low power tickless implementations, where
+                     * this can prevent an unnecessary exit from low power
+                     * state. */
+                    prvResetNextTaskUnblockTime();
+                }
+
+                /* If any ticks occurred while the scheduler was suspended then
+                 * they should be processed now.  This ensures the tick count does
+                 * not  slip, and that any delayed tasks are resumed at the correct
+                 * time. */
+                {
+                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                    if( xPendedCounts > ( TickType_t ) 0U )
+                    {
+                        do
+                        {
+                            if( xTaskIncrementTick() != pdFALSE )
+                            {
+                                xYieldPending = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            --xPendedCounts;
+                        } while( xPendedCounts > ( TickType_t ) 0U );
+
+                        xPendedTicks = 0;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldPending != pdFALSE )
+                {
+                    #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                    #endif
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xAlreadyYielded;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    TickType_t xTicks;
+
+    /* Critical section required if running on a 16 bit processor. */
+    portTICK_TYPE_ENTER_CRITICAL();
+    {
+        xTicks = xTickCount;
+    }
+    portTICK_TYPE_EXIT_CRITICAL();
+
+    return xTicks;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCountFromISR( void )
+{
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = xTickCount;
+    }
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    /* A critical section is not required because the variables are of type
+     * BaseType_t. */
+    return uxCurrentNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
+
+char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+    TCB_t * pxTCB;
+
+    /* If null is passed in here then the name of the calling task is being
+     * queried. */
+    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+    configASSERT( pxTCB );
+    return &( pxTCB->pcTaskName[ 0 ] );
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] )
+    {
+        TCB_t * pxNextTCB, * pxFirstTCB, * pxReturn = NULL;
+        UBaseType_t x;
+        char cNextChar;
+        BaseType_t xBreakLoop;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                /* Check each character in the name looking for a match or
+                 * mismatch. */
+                xBreakLoop = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    cNextChar = pxNextTCB->pcTaskName[ x ];
+
+                    if( cNextChar != pcNameToQuery[ x ] )
+                    {
+                        /* Characters didn't match. */
+                        xBreakLoop = pdTRUE;
+                    }
+                    else if( cNextChar == ( char ) 0x00 )
+                    {
+                        /* Both strings terminated, a match must have been
+                         * found. */
+                        pxReturn = pxNextTCB;
+                        xBreakLoop = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xBreakLoop != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+
+                if( pxReturn != NULL )
+                {
+                    /* The handle has been found. */
+                    break;
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The ready tasks are in the EDF ready list instead, and
+                     * the idle task in the background list. */
+                    if( pxTCB == NULL )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &xReadyTasksListEDF, pcNameToQuery );
+                    }
+
+                    if( pxTCB == NULL )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &xBackgroundListEDF, pcNameToQuery );
+                    }
+                }
+            #endif
+
+            /* Search the delayed lists. */
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+            }
+
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+            }
+
+            #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    /* The delayed tasks are in the timing wheel instead. */
+                    for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) configEDF_TIMING_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                    {
+                        for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) taskEDF_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                        {
+                            pxTCB = prvSearchForNameWithinSingleList( &( xTimingWheelEDF[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                        }
+                    }
+                }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        /* Search the suspended list. */
+                        pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                    }
+                }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        /* Search the deleted list. */
+                        pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                    }
+                }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return pxTCB;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Ready state. */
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* The ready tasks are in the EDF ready list instead,
+                         * and the idle task in the background list. */
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xReadyTasksListEDF, eReady );
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xBackgroundListEDF, eReady );
+                    }
+                #endif
+
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Blocked state. */
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+
+                #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+                    {
+                        UBaseType_t uxLevel, uxSlot;
+
+                        /* The delayed tasks are in the timing wheel instead. */
+                        for( uxLevel = 0; uxLevel < ( UBaseType_t ) configEDF_TIMING_WHEEL_LEVELS; uxLevel++ )
+                        {
+                            for( uxSlot = 0; uxSlot < ( UBaseType_t ) taskEDF_WHEEL_SLOTS; uxSlot++ )
+                            {
+                                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheelEDF[ uxLevel ][ uxSlot ] ), eBlocked );
+                            }
+                        }
+                    }
+                #endif
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                    {
+                        /* Fill in an TaskStatus_t structure with information on
+                         * each task that has been deleted but not yet cleaned up. */
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                    }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    {
+                        /* Fill in an TaskStatus_t structure with information on
+                         * each task in the Suspended state. */
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                    }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                    {
+                        if( pulTotalRunTime != NULL )
+                        {
+                            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                                portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                            #else
+                                *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                            #endif
+                        }
+                    }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                    {
+                        if( pulTotalRunTime != NULL )
+                        {
+                            *pulTotalRunTime = 0;
+                        }
+                    }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    {
+        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+         * started, then xIdleTaskHandle will be NULL. */
+        configASSERT( ( xIdleTaskHandle != NULL ) );
+        return xIdleTaskHandle;
+    }
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( const TickType_t xTicksToJump )
+    {
+        TickType_t xTicksToStep = xTicksToJump;
+
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick. */
+        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+
+        #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+            {
+                /* The timing wheel only acts on ticks processed by
+                 * xTaskIncrementTick(), so a tick it has work for cannot be
+                 * stepped over.  It is left pending instead.  The port calls
+                 * this function with interrupts disabled. */
+                if( ( xTickCount + xTicksToStep ) == xNextTaskUnblockTime )
+                {
+                    configASSERT( xTicksToStep != ( TickType_t ) 0U );
+                    xPendedTicks++;
+                    xTicksToStep--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        xTickCount += xTicksToStep;
+        traceINCREASE_TICK_COUNT( xTicksToStep );
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == 0 );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+    xPendedTicks += xTicksToCatchUp;
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state. */
+            if( eTaskGetState( xTask ) == eBlocked )
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddWokenTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        #if ( configUSE_EDF_SCHEDULER == 0 )
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #else
+                            if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                        #endif
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    #if ( configUSE_EDF_TIMING_WHEEL == 0 )
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+    #endif
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configUSE_EDF_TRACE_RECORDER == 1 )
+        /* xTaskResumeAll() replays pended ticks from a task, with the
+         * scheduler running and xPendedTicks not yet wound down to 0.  Every
+         * other call comes from the tick interrupt, the only interrupt the
+         * kernel sees the entry of. */
+        const BaseType_t xFromTickISR = ( ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) || ( xPendedTicks == ( TickType_t ) 0 ) ) ? pdTRUE : pdFALSE;
+
+        if( xFromTickISR != pdFALSE )
+        {
+            traceEDF_ISR_ENTER( edfTRACE_ISR_TICK );
+        }
+    #endif
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+            {
+                /****************************************************************************
+                 ***********	 EDF modification: Release from the timing wheel	 ************
+                 ****************************************************************************/
+
+                if( prvTimingWheelTick( xConstTickCount ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
+                    {
+                        /* prvGetExpectedIdleTime() sets xNextTaskUnblockTime
+                         * before the tick is suppressed.  Once it has passed
+                         * the value is no longer needed. */
+                        if( xConstTickCount >= xNextTaskUnblockTime )
+                        {
+                            xNextTaskUnblockTime = portMAX_DELAY;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif
+            }
+        #else /* configUSE_EDF_TIMING_WHEEL */
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                {
+                    /* The delayed list is empty.  Set xNextTaskUnblockTime
+                     * to the maximum possible value so it is extremely
+                     * unlikely that the
+                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                     * next time through. */
+                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    break;
+                }
+                else
+                {
+                    /* The delayed list is not empty, get the value of the
+                     * item at the head of the delayed list.  This is the time
+                     * at which the task at the head of the delayed list must
+                     * be removed from the Blocked state. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                    if( xConstTickCount < xItemValue )
+                    {
+                        /* It is not time to unblock this item yet, but the
+                         * item value is the time at which the task at the head
+                         * of the blocked list must be removed from the Blocked
+                         * state -  so record the item value in
+                         * xNextTaskUnblockTime. */
+                        xNextTaskUnblockTime = xItemValue;
+                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* It is time to remove the item from the Blocked state. */
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+										
+
+                    /* Is the task waiting on an event also?  If so remove
+                     * it from the event list. */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+										
+/********************************************************************************
+ ***********	 EDF modification: Calculate new deadline of the task	 ************
+ ********************************************************************************/
+																		
+									/* prvAddTaskToReadyList() sets the deadline from the release
+									 * time recorded when the previous job completed. */
+									traceEDF_TASK_RELEASED( pxTCB );
+
+                    #if ( configUSE_EDF_BATCH_RELEASE == 1 )
+                        {
+                            /* The tasks released by this tick are moved to
+                             * the ready queue together once the loop ends. */
+                            prvAddTaskToReleaseBatch( pxTCB );
+                        }
+                    #else /* configUSE_EDF_BATCH_RELEASE */
+
+                    /* Place the unblocked task into the appropriate ready
+                     * list. */
+                    prvAddWokenTaskToReadyList( pxTCB );
+				
+                    /* A task being unblocked cannot cause an immediate
+                     * context switch if preemption is turned off. */
+                    #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            /* Preemption is on, but a context switch should
+                             * only be performed if the unblocked task has a
+                             * priority that is equal to or higher than the
+                             * currently executing task. */
+													#if (configUSE_EDF_SCHEDULER == 0)
+                            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+													#else
+													
+					/*******************************************************************************************************************************
+					 ***********	 EDF modification: invoke switch context API if deadline of the unblocked task is closer than current ************
+					 *******************************************************************************************************************************/
+														if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+													#endif
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif /* configUSE_PREEMPTION */
+                    #endif /* configUSE_EDF_BATCH_RELEASE */
+                }
+            }
+
+            #if ( configUSE_EDF_BATCH_RELEASE == 1 )
+                {
+                    /****************************************************************************
+                     ***********	 EDF modification: Release the batch of this tick	 ************
+                     ****************************************************************************/
+
+                    if( prvEDFReleaseBatch() != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif /* configUSE_EDF_BATCH_RELEASE */
+        }
+        #endif /* configUSE_EDF_TIMING_WHEEL */
+
+				#if ( configUSE_EDF_SCHEDULER == 1 )
+						{
+							#if ( configUSE_EDF_CBS == 1 )
+								{
+									/****************************************************************************
+									 ***********	 EDF modification: Charge the tick to the CBS budget	 ************
+									 ****************************************************************************/
+
+									/* Charge the tick to the server of the running task.  When the
+									 * budget is used up it is recharged and the server deadline is
+									 * postponed by one server period, so the task can never use more
+									 * than its bandwidth. */
+									if( pxCurrentTCB->xCBSBudget != ( TickType_t ) 0U )
+									{
+										( pxCurrentTCB->xCBSRemaining )--;
+
+										if( pxCurrentTCB->xCBSRemaining == ( TickType_t ) 0U )
+										{
+											pxCurrentTCB->xCBSRemaining = pxCurrentTCB->xCBSBudget;
+											pxCurrentTCB->xTaskReleaseTime += pxCurrentTCB->xTaskRelativeDeadline;
+
+											if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+											{
+												( void ) prvRemoveTaskFromStateList( pxCurrentTCB );
+												prvAddTaskToReadyList( pxCurrentTCB );
+												xSwitchRequired = pdTRUE;
+											}
+											else
+											{
+												mtCOVERAGE_TEST_MARKER();
+											}
+										}
+										else
+										{
+											mtCOVERAGE_TEST_MARKER();
+										}
+									}
+									else
+									{
+										mtCOVERAGE_TEST_MARKER();
+									}
+								}
+							#endif /* configUSE_EDF_CBS */
+
+							#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+								{
+									/****************************************************************************
+									 ***********	 EDF modification: Enforce the execution time budget	 ************
+									 ****************************************************************************/
+
+									/* Execution time is charged precisely on every context switch, the
+									 * tick only bounds how long an overrun can go unnoticed. */
+									prvChargeBudget();
+
+									if( prvEnforceBudget() != pdFALSE )
+									{
+										xSwitchRequired = pdTRUE;
+									}
+									else
+									{
+										mtCOVERAGE_TEST_MARKER();
+									}
+								}
+							#endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
+
+							#if ( configUSE_EDF_LOAD_WINDOW == 1 )
+								{
+									/****************************************************************************
+									 ***********	 EDF modification: Close the load window	 ************
+									 ****************************************************************************/
+
+									prvLoadWindowTick( xConstTickCount );
+								}
+							#endif
+
+							/****************************************************************************
+							 ***********	 EDF modification: Detect jobs past their deadline	 ************
+							 ****************************************************************************/
+
+							/* The running task and every ready task up to the first one with
+							 * a deadline still to come are checked, so a job that misses its
+							 * deadline while it waits behind an equal or inherited deadline is
+							 * reported at the tick it misses it.  Blocked jobs are checked when
+							 * they complete. */
+							prvCheckDeadlineMiss( pxCurrentTCB, xConstTickCount );
+							prvCheckReadyDeadlineMisses( xConstTickCount );
+						}
+				#endif
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            {
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+            {
+                /* Guard against the tick hook being called when the pended tick
+                 * count is being unwound (when the scheduler is being unlocked). */
+                if( xPendedTicks == ( TickType_t ) 0 )
+                {
+                    vApplicationTickHook();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+            {
+                vApplicationTickHook();
+            }
+        #endif
+    }
+
+    #if ( configUSE_EDF_TRACE_RECORDER == 1 )
+        if( xFromTickISR != pdFALSE )
+        {
+            /* The port switches context, if required, after this returns. */
+            traceEDF_ISR_EXIT( edfTRACE_ISR_TICK );
+        }
+    #endif
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    {
+        /* The scheduler is currently suspended - do not allow a context
+         * switch. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        traceTASK_SWITCHED_OUT();
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
+            }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
+        #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+            {
+                /* Charge the task being switched out up to now, the task
+                 * switched in is charged from here on. */
+                prvChargeBudget();
+            }
+        #endif
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_EXECUTION_TIME == 1 ) )
+            {
+                /* Unsigned subtraction gives the right slice across a wrap of
+                 * the clock. */
+                ulExecutionTimeNow = configEDF_CLOCK();
+                pxCurrentTCB->ulExecutionTime += ulExecutionTimeNow - pxCurrentTCB->ulSwitchedInTime;
+            }
+        #endif
+
+        /* Check for stack overflow, if configured. */
+        taskCHECK_FOR_STACK_OVERFLOW();
+
+        /* Before the currently running task is switched out, save its errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            }
+        #endif
+
+        /* Select a new task to run using either the generic C or port
+         * optimised asm code. */
+				 
+				#if (configUSE_EDF_SCHEDULER == 0)				
+        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */		
+				#else		
+				taskSELECT_EARLIEST_DEADLINE_TASK();
+				#endif
+
+        #if ( configUSE_EDF_SHARED_STACK == 1 )
+            {
+                prvSharedStackSwitchIn();
+            }
+        #endif
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_EXECUTION_TIME == 1 ) )
+            {
+                pxCurrentTCB->ulSwitchedInTime = ulExecutionTimeNow;
+            }
+        #endif
+				
+				traceTASK_SWITCHED_IN();
+
+        /* After the new task is switched in, update the global errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            }
+        #endif
+
+        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            {
+                /* Switch Newlib's _impure_ptr variable to point to the _reent
+                 * structure specific to this task.
+                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+                 * for additional information. */
+                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+            }
+        #endif /* configUSE_NEWLIB_REENTRANT */
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    #if ( configUSE_EDF_SCHEDULER == 0 )
+        {
+            vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+    #else
+        {
+            /* Under EDF every task has the same priority, so the list is
+             * ordered by deadline instead. */
+            prvEDFEventListInsert( pxEventList, pxCurrentTCB );
+        }
+    #endif
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
+
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddWokenTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+                 * might be set to the blocked task's time out time.  If the task is
+                 * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+                 * normally left unchanged, because it is automatically reset to a new
+                 * value when the tick count equals xNextTaskUnblockTime.  However if
+                 * tickless idling is used it might be more important to enter sleep mode
+                 * at the earliest possible time - so reset xNextTaskUnblockTime here to
+                 * ensure it is updated at the earliest possible time. */
+                prvResetNextTaskUnblockTime();
+            }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    #if ( configUSE_EDF_SCHEDULER == 0 )
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #else
+        if( taskEDF_PREEMPTS_CURRENT( pxUnblockedTCB ) )
+    #endif
+    {
+        /* Return true if the task removed from the event list has a higher
+         * priority than the calling task.  This allows the calling task to know if
+         * it should force a context switch now. */
+        xReturn = pdTRUE;
+
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddWokenTaskToReadyList( pxUnblockedTCB );
+
+    #if ( configUSE_EDF_SCHEDULER == 0 )
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #else
+        if( taskEDF_PREEMPTS_CURRENT( pxUnblockedTCB ) )
+    #endif
+    {
+        /* The unblocked task has a priority above that of the calling task, so
+         * a context switch is required.  This function is called with the
+         * scheduler suspended so xYieldPending is set so the context switch
+         * occurs immediately that the scheduler is resumed (unsuspended). */
+        xYieldPending = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
         }
-        taskEXIT_CRITICAL();
     }
+    taskEXIT_CRITICAL();
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+    return xReturn;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+void vTaskMissedYield( void )
+{
+    xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
+        if( xTask != NULL )
         {
-            xReturn = pxTCB->pxTaskTag;
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
+        }
+        else
+        {
+            uxReturn = 0U;
         }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
+        return uxReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
     {
         TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
-
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        if( xTask != NULL )
         {
-            xReturn = pxTCB->pxTaskTag;
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-        return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+#endif /* configUSE_TRACE_FACILITY */
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
-    {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
-        {
-            xTCB = pxCurrentTCB;
-        }
-        else
-        {
-            xTCB = xTask;
-        }
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
 
-        if( xTCB->pxTaskTag != NULL )
-        {
-            xReturn = xTCB->pxTaskTag( pvParameter );
-        }
-        else
-        {
-            xReturn = pdFAIL;
-        }
+    for( ; ; )
+    {
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
 
-        return xReturn;
-    }
+        #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* If we are not using preemption we keep forcing a task switch to
+                 * see if any other task has become available.  If we are using
+                 * preemption we don't need to do this as any task becoming available
+                 * will automatically get the processor anyway. */
+                taskYIELD();
+            }
+        #endif /* configUSE_PREEMPTION */
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* When using preemption tasks of equal priority will be
+                 * timesliced.  If a task that is sharing the idle priority is ready
+                 * to run then the idle task should yield before the end of the
+                 * timeslice.
+                 *
+                 * A critical region is not required here as we are just reading from
+                 * the list, and an occasional incorrect value will not matter.  If
+                 * the ready list at the idle priority contains more than one task
+                 * then a task other than the idle task is ready to execute. */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+						
+        #if ( configUSE_IDLE_HOOK == 1 )
+            {
+                extern void vApplicationIdleHook( void );
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
-    {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+                /* Call the user defined function from within the idle task.  This
+                 * allows the application designer to add background functionality
+                 * without the overhead of a separate task.
+                 * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+                 * CALL A FUNCTION THAT MIGHT BLOCK. */
+                vApplicationIdleHook();
+            }
+        #endif /* configUSE_IDLE_HOOK */
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
             {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-                #else
-                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                #endif
+                TickType_t xExpectedIdleTime;
 
-                /* Add the amount of time the task has been running to the
-                 * accumulated time so far.  The time the task started running was
-                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-                 * protection here so count values are only valid until the timer
-                 * overflows.  The guard against negative values is to protect
-                 * against suspect run time stat counter implementations - which
-                 * are provided by the application, not the kernel. */
-                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                /* It is not desirable to suspend then resume the scheduler on
+                 * each iteration of the idle task.  Therefore, a preliminary
+                 * test of the expected idle time is performed without the
+                 * scheduler suspended.  The result here is not necessarily
+                 * valid. */
+                xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
                 {
-                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    vTaskSuspendAll();
+                    {
+                        /* Now the scheduler is suspended, the expected idle
+                         * time can be sampled again, and this time its value can
+                         * be used. */
+                        configASSERT( xNextTaskUnblockTime >= xTickCount );
+                        xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                        /* Define the following macro to set xExpectedIdleTime to 0
+                         * if the application does not want
+                         * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                        configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                        if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                        {
+                            traceLOW_POWER_IDLE_BEGIN();
+                            portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                            traceLOW_POWER_IDLE_END();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    ( void ) xTaskResumeAll();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                ulTaskSwitchedInTime = ulTotalRunTime;
             }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+        #endif /* configUSE_TICKLESS_IDLE */
+    }
+}
+/*-----------------------------------------------------------*/
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        /* The idle task exists in addition to the application tasks. */
+        const UBaseType_t uxNonApplicationTasks = 1;
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
+
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xYieldPending != pdFALSE )
+        {
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
+        }
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            else if( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE )
             {
-                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+                /* A job was released after the idle task decided to sleep. */
+                eReturn = eAbortSleep;
             }
         #endif
-
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-				 
-				#if (configUSE_EDF_SCHEDULER == 0)				
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */		
-				#else		
-				pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
-				#endif
-				
-				traceTASK_SWITCHED_IN();
-
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        else
+        {
+            /* If all the tasks are in the suspended list (which might mean they
+             * have an infinite block time rather than actually being suspended)
+             * then it is safe to turn all clocks off and just wait for external
+             * interrupts. */
+            if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
             {
-                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+                eReturn = eNoTasksWaitingTimeout;
             }
-        #endif
-
-        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            else
             {
-                /* Switch Newlib's _impure_ptr variable to point to the _reent
-                 * structure specific to this task.
-                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-                 * for additional information. */
-                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif /* configUSE_NEWLIB_REENTRANT */
+        }
+
+        return eReturn;
     }
-}
+
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
+    {
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        return pvReturn;
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( portUSING_MPU_WRAPPERS == 1 )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
     {
-        configASSERT( pxEventList );
+        TCB_t * pxTCB;
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
 
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+    }
 
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
-        {
-            xTicksToWait = portMAX_DELAY;
-        }
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
 
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
-#endif /* configUSE_TIMERS */
-/*-----------------------------------------------------------*/
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
+		
+		/********************************************************************************
+		 ***************	 EDF modification: Initialise EDF ready list	 ****************
+		 ********************************************************************************/
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+				{
+						vListInitialise( &xReadyTasksListEDF );
+						vListInitialise( &xBackgroundListEDF );
+
+						#if ( configUSE_EDF_BATCH_RELEASE == 1 )
+								vListInitialise( &xReleaseBatchEDF );
+						#endif
+
+						#if ( configUSE_EDF_TIMING_WHEEL == 1 )
+								{
+										UBaseType_t uxLevel, uxSlot;
+
+										for( uxLevel = 0; uxLevel < ( UBaseType_t ) configEDF_TIMING_WHEEL_LEVELS; uxLevel++ )
+										{
+												for( uxSlot = 0; uxSlot < ( UBaseType_t ) taskEDF_WHEEL_SLOTS; uxSlot++ )
+												{
+														vListInitialise( &( xTimingWheelEDF[ uxLevel ][ uxSlot ] ) );
+												}
+										}
+								}
+						#endif
+			  }
+		#endif
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
+    #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            vListInitialise( &xTasksWaitingTermination );
+        }
+    #endif /* INCLUDE_vTaskDelete */
 
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
+    #if ( INCLUDE_vTaskSuspend == 1 )
+        {
+            vListInitialise( &xSuspendedTaskList );
+        }
+    #endif /* INCLUDE_vTaskSuspend */
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+}
+/*-----------------------------------------------------------*/
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 0 ) )
+
+    static void prvEDFReadyListInsert( TCB_t * pxTCB )
     {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
+        const ListItem_t * const pxListEnd = listGET_END_MARKER( &xReadyTasksListEDF );
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        /* Move past every task whose deadline is not after the new one, so
+         * tasks with equal deadlines are served in the order they became
+         * ready, as with vListInsert(). */
+        for( pxIterator = ( ListItem_t * ) pxListEnd;
+             listGET_NEXT( pxIterator ) != pxListEnd;
+             pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        {
+            if( taskEDF_TIME_BEFORE( pxTCB->xAbsoluteDeadline, ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( listGET_NEXT( pxIterator ) ) )->xAbsoluteDeadline ) )
             {
-                /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-                 * might be set to the blocked task's time out time.  If the task is
-                 * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-                 * normally left unchanged, because it is automatically reset to a new
-                 * value when the tick count equals xNextTaskUnblockTime.  However if
-                 * tickless idling is used it might be more important to enter sleep mode
-                 * at the earliest possible time - so reset xNextTaskUnblockTime here to
-                 * ensure it is updated at the earliest possible time. */
-                prvResetNextTaskUnblockTime();
+                break;
             }
-        #endif
-    }
-    else
-    {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-    }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        pxNewListItem->pxNext = pxIterator->pxNext;
+        pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+        pxNewListItem->pxPrevious = pxIterator;
+        pxIterator->pxNext = pxNewListItem;
+        pxNewListItem->pxContainer = &xReadyTasksListEDF;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+        ( xReadyTasksListEDF.uxNumberOfItems )++;
     }
-    else
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvEDFEventListInsert( List_t * const pxEventList,
+                                       TCB_t * pxTCB )
     {
-        xReturn = pdFALSE;
+        ListItem_t * const pxNewListItem = &( pxTCB->xEventListItem );
+        ListItem_t * pxIterator;
+        const ListItem_t * const pxListEnd = listGET_END_MARKER( pxEventList );
+
+        /* As prvEDFReadyListInsert(), tasks with equal deadlines are woken in
+         * the order they started to wait. */
+        for( pxIterator = ( ListItem_t * ) pxListEnd;
+             listGET_NEXT( pxIterator ) != pxListEnd;
+             pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        {
+            if( taskEDF_TIME_BEFORE( pxTCB->xAbsoluteDeadline, ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( listGET_NEXT( pxIterator ) ) )->xAbsoluteDeadline ) )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxNewListItem->pxNext = pxIterator->pxNext;
+        pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+        pxNewListItem->pxPrevious = pxIterator;
+        pxIterator->pxNext = pxNewListItem;
+        pxNewListItem->pxContainer = pxEventList;
+
+        ( pxEventList->uxNumberOfItems )++;
     }
+/*-----------------------------------------------------------*/
 
-    return xReturn;
-}
+    #if ( configUSE_MUTEXES == 1 )
+
+        static void prvEDFEventListReposition( TCB_t * pxTCB )
+        {
+            List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+            /* Event groups keep their waiting tasks unordered, and a task in
+             * the pending ready list is no longer waiting. */
+            if( ( pxEventList != NULL ) &&
+                ( pxEventList != &xPendingReadyList ) &&
+                ( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL ) )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                prvEDFEventListInsert( pxEventList, pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_MUTEXES */
+
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) )
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
+    static void prvReadyHeapInsert( TCB_t * pxTCB )
+    {
+        UBaseType_t uxIndex, uxParent;
 
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+        configASSERT( uxReadyHeapLengthEDF < ( UBaseType_t ) configEDF_MAX_READY_TASKS );
 
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+        /* Start at the first free leaf and move the parent down until the
+         * slot for the new task is found.  Equal deadlines are not swapped so
+         * tasks with the same deadline stay in arrival order along a path. */
+        uxIndex = uxReadyHeapLengthEDF;
+        uxReadyHeapLengthEDF++;
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+        while( uxIndex > ( UBaseType_t ) 0U )
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
-        }
-    #endif
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
 
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
+            if( taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxTCB ), taskEDF_DEADLINE( pxReadyHeapEDF[ uxParent ] ) ) == pdFALSE )
+            {
+                break;
+            }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+            pxReadyHeapEDF[ uxIndex ] = pxReadyHeapEDF[ uxParent ];
+            pxReadyHeapEDF[ uxIndex ]->uxReadyHeapIndex = uxIndex;
+            uxIndex = uxParent;
+        }
+
+        pxReadyHeapEDF[ uxIndex ] = pxTCB;
+        pxTCB->uxReadyHeapIndex = uxIndex;
     }
-}
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+    static void prvReadyHeapRemove( TCB_t * pxTCB )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
-    }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
+        UBaseType_t uxIndex, uxParent, uxChild;
+        TCB_t * pxLast;
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+        configASSERT( uxReadyHeapLengthEDF > ( UBaseType_t ) 0U );
+        configASSERT( pxReadyHeapEDF[ pxTCB->uxReadyHeapIndex ] == pxTCB );
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
+        uxReadyHeapLengthEDF--;
+        pxLast = pxReadyHeapEDF[ uxReadyHeapLengthEDF ];
+        uxIndex = pxTCB->uxReadyHeapIndex;
 
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+        if( pxLast != pxTCB )
+        {
+            /* Fill the hole with the last leaf.  It may have to move towards
+             * the root... */
+            while( uxIndex > ( UBaseType_t ) 0U )
+            {
+                uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
 
-    taskENTER_CRITICAL();
-    {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+                if( taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxLast ), taskEDF_DEADLINE( pxReadyHeapEDF[ uxParent ] ) ) == pdFALSE )
+                {
+                    break;
+                }
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
-            {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
+                pxReadyHeapEDF[ uxIndex ] = pxReadyHeapEDF[ uxParent ];
+                pxReadyHeapEDF[ uxIndex ]->uxReadyHeapIndex = uxIndex;
+                uxIndex = uxParent;
             }
-            else
-        #endif
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
+            /* ...or towards the leaves, never both. */
+            for( ; ; )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
+                uxChild = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
+
+                if( uxChild >= uxReadyHeapLengthEDF )
+                {
+                    break;
+                }
+
+                if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxReadyHeapLengthEDF ) &&
+                    taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxReadyHeapEDF[ uxChild + ( UBaseType_t ) 1U ] ), taskEDF_DEADLINE( pxReadyHeapEDF[ uxChild ] ) ) )
+                {
+                    uxChild++;
+                }
+
+                if( taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxReadyHeapEDF[ uxChild ] ), taskEDF_DEADLINE( pxLast ) ) == pdFALSE )
+                {
+                    break;
+                }
+
+                pxReadyHeapEDF[ uxIndex ] = pxReadyHeapEDF[ uxChild ];
+                pxReadyHeapEDF[ uxIndex ]->uxReadyHeapIndex = uxIndex;
+                uxIndex = uxChild;
             }
-            else
-        #endif
 
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-        {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
-        }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
-        {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
+            pxReadyHeapEDF[ uxIndex ] = pxLast;
+            pxLast->uxReadyHeapIndex = uxIndex;
         }
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            mtCOVERAGE_TEST_MARKER();
         }
-    }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
+        pxReadyHeapEDF[ uxReadyHeapLengthEDF ] = NULL;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    static UBaseType_t prvEDFStateListRemove( TCB_t * pxTCB )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
-
-        if( xTask != NULL )
+        if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            prvReadyHeapRemove( pxTCB );
         }
         else
         {
-            uxReturn = 0U;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxReturn;
+        return uxListRemove( &( pxTCB->xStateListItem ) );
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_EDF_BATCH_RELEASE == 1 )
 
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
-    {
-        TCB_t * pxTCB;
+    #if ( configUSE_EDF_READY_HEAP == 0 )
 
-        if( xTask != NULL )
+        static ListItem_t * prvEDFSortBatch( ListItem_t * pxHead )
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
-        }
-    }
+            ListItem_t * pxP, * pxQ, * pxItem, * pxTail;
+            UBaseType_t uxWidth, uxPSize, uxQSize, uxMerges;
 
-#endif /* configUSE_TRACE_FACILITY */
+            /* Bottom up merge sort, which needs no recursion and no memory
+             * beyond the list items themselves.  Each pass merges neighbouring
+             * runs of uxWidth items.  An item of the second run is only taken
+             * first if its deadline is strictly earlier, so tasks with equal
+             * deadlines keep the order in which they were unblocked. */
+            for( uxWidth = ( UBaseType_t ) 1U; ; uxWidth <<= 1 )
+            {
+                pxP = pxHead;
+                pxHead = NULL;
+                pxTail = NULL;
+                uxMerges = ( UBaseType_t ) 0U;
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-    /* Stop warnings. */
-    ( void ) pvParameters;
+                while( pxP != NULL )
+                {
+                    uxMerges++;
+                    pxQ = pxP;
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+                    for( uxPSize = ( UBaseType_t ) 0U; ( uxPSize < uxWidth ) && ( pxQ != NULL ); uxPSize++ )
+                    {
+                        pxQ = pxQ->pxNext;
+                    }
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+                    uxQSize = uxWidth;
 
-    for( ; ; )
-    {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+                    while( ( uxPSize > ( UBaseType_t ) 0U ) || ( ( uxQSize > ( UBaseType_t ) 0U ) && ( pxQ != NULL ) ) )
+                    {
+                        if( ( uxPSize == ( UBaseType_t ) 0U ) ||
+                            ( ( uxQSize > ( UBaseType_t ) 0U ) && ( pxQ != NULL ) &&
+                              ( taskEDF_TIME_BEFORE( taskEDF_ITEM_DEADLINE( pxQ ), taskEDF_ITEM_DEADLINE( pxP ) ) != pdFALSE ) ) )
+                        {
+                            pxItem = pxQ;
+                            pxQ = pxQ->pxNext;
+                            uxQSize--;
+                        }
+                        else
+                        {
+                            pxItem = pxP;
+                            pxP = pxP->pxNext;
+                            uxPSize--;
+                        }
 
-        #if ( configUSE_PREEMPTION == 0 )
-            {
-                /* If we are not using preemption we keep forcing a task switch to
-                 * see if any other task has become available.  If we are using
-                 * preemption we don't need to do this as any task becoming available
-                 * will automatically get the processor anyway. */
-                taskYIELD();
+                        if( pxTail == NULL )
+                        {
+                            pxHead = pxItem;
+                        }
+                        else
+                        {
+                            pxTail->pxNext = pxItem;
+                        }
+
+                        pxTail = pxItem;
+                    }
+
+                    pxP = pxQ;
+                }
+
+                pxTail->pxNext = NULL;
+
+                if( uxMerges <= ( UBaseType_t ) 1U )
+                {
+                    break;
+                }
             }
-        #endif /* configUSE_PREEMPTION */
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            return pxHead;
+        }
+
+    #endif /* configUSE_EDF_READY_HEAP */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvEDFReleaseBatch( void )
+    {
+        TCB_t * pxEarliest = NULL;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        #if ( configUSE_EDF_READY_HEAP == 0 )
             {
-                /* When using preemption tasks of equal priority will be
-                 * timesliced.  If a task that is sharing the idle priority is ready
-                 * to run then the idle task should yield before the end of the
-                 * timeslice.
-                 *
-                 * A critical region is not required here as we are just reading from
-                 * the list, and an occasional incorrect value will not matter.  If
-                 * the ready list at the idle priority contains more than one task
-                 * then a task other than the idle task is ready to execute. */
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+                ListItem_t * pxBatch, * pxItem;
+                ListItem_t * pxIterator = ( ListItem_t * ) listGET_END_MARKER( &xReadyTasksListEDF );
+                const ListItem_t * const pxListEnd = listGET_END_MARKER( &xReadyTasksListEDF );
+
+                if( listLIST_IS_EMPTY( &xReleaseBatchEDF ) == pdFALSE )
                 {
-                    taskYIELD();
+                    /* Take the batch out of its list as a NULL terminated
+                     * chain and sort it. */
+                    pxBatch = listGET_HEAD_ENTRY( &xReleaseBatchEDF );
+                    xReleaseBatchEDF.xListEnd.pxPrevious->pxNext = NULL;
+                    vListInitialise( &xReleaseBatchEDF );
+                    pxBatch = prvEDFSortBatch( pxBatch );
+                    pxEarliest = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxBatch );
+
+                    /* Merge the sorted batch into the ready list.  Each task
+                     * goes after every ready task whose deadline is not later
+                     * than its own, as prvEDFReadyListInsert() would place it,
+                     * and the walk carries on from there for the next one, so
+                     * the ready list is walked once for the whole batch. */
+                    while( pxBatch != NULL )
+                    {
+                        pxItem = pxBatch;
+                        pxBatch = pxBatch->pxNext;
+                        listSET_LIST_ITEM_VALUE( pxItem, taskEDF_ITEM_DEADLINE( pxItem ) );
+
+                        while( ( listGET_NEXT( pxIterator ) != pxListEnd ) &&
+                               ( taskEDF_TIME_BEFORE( taskEDF_ITEM_DEADLINE( pxItem ), taskEDF_ITEM_DEADLINE( listGET_NEXT( pxIterator ) ) ) == pdFALSE ) )
+                        {
+                            pxIterator = listGET_NEXT( pxIterator );
+                        }
+
+                        pxItem->pxNext = pxIterator->pxNext;
+                        pxItem->pxNext->pxPrevious = pxItem;
+                        pxItem->pxPrevious = pxIterator;
+                        pxIterator->pxNext = pxItem;
+                        pxItem->pxContainer = &xReadyTasksListEDF;
+
+                        ( xReadyTasksListEDF.uxNumberOfItems )++;
+                        pxIterator = pxItem;
+                    }
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-						
-        #if ( configUSE_IDLE_HOOK == 1 )
+        #else /* configUSE_EDF_READY_HEAP */
             {
-                extern void vApplicationIdleHook( void );
+                TCB_t * pxTCB;
 
-                /* Call the user defined function from within the idle task.  This
-                 * allows the application designer to add background functionality
-                 * without the overhead of a separate task.
-                 * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-                 * CALL A FUNCTION THAT MIGHT BLOCK. */
-                vApplicationIdleHook();
+                /* Each heap insert is O( log n ) already, so the batch is not
+                 * sorted.  Only the earliest deadline is kept for the
+                 * preemption decision. */
+                while( listLIST_IS_EMPTY( &xReleaseBatchEDF ) == pdFALSE )
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xReleaseBatchEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    listINSERT_END( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) );
+                    prvReadyHeapInsert( pxTCB );
+
+                    if( ( pxEarliest == NULL ) || ( taskEDF_TIME_BEFORE( taskEDF_DEADLINE( pxTCB ), taskEDF_DEADLINE( pxEarliest ) ) != pdFALSE ) )
+                    {
+                        pxEarliest = pxTCB;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
-        #endif /* configUSE_IDLE_HOOK */
+        #endif /* configUSE_EDF_READY_HEAP */
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        #if ( configUSE_PREEMPTION == 1 )
             {
-                TickType_t xExpectedIdleTime;
-
-                /* It is not desirable to suspend then resume the scheduler on
-                 * each iteration of the idle task.  Therefore, a preliminary
-                 * test of the expected idle time is performed without the
-                 * scheduler suspended.  The result here is not necessarily
-                 * valid. */
-                xExpectedIdleTime = prvGetExpectedIdleTime();
-
-                if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                /* No other task of the batch can preempt if the earliest does
+                 * not. */
+                if( ( pxEarliest != NULL ) && taskEDF_BEFORE_CURRENT( taskEDF_DEADLINE( pxEarliest ) ) )
                 {
-                    vTaskSuspendAll();
-                    {
-                        /* Now the scheduler is suspended, the expected idle
-                         * time can be sampled again, and this time its value can
-                         * be used. */
-                        configASSERT( xNextTaskUnblockTime >= xTickCount );
-                        xExpectedIdleTime = prvGetExpectedIdleTime();
-
-                        /* Define the following macro to set xExpectedIdleTime to 0
-                         * if the application does not want
-                         * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                        configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
-
-                        if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                        {
-                            traceLOW_POWER_IDLE_BEGIN();
-                            portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                            traceLOW_POWER_IDLE_END();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    ( void ) xTaskResumeAll();
+                    xSwitchRequired = pdTRUE;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        #endif /* configUSE_TICKLESS_IDLE */
-				
-				#if (configUSE_EDF_SCHEDULER == 1)
-						{
-							/**********************************************************************************************************
-							 ***********	 EDF modification: Extend idle task deadline and put it at the end of the list	 ************
-							 **********************************************************************************************************/
-							
-							listSET_LIST_ITEM_VALUE( &( ( pxCurrentTCB )->xStateListItem ), ( pxCurrentTCB)->xTaskPeriod +   xTaskGetTickCount());
-							listINSERT_END( &(xReadyTasksListEDF), &( ( pxCurrentTCB )->xStateListItem ) );
-						}
-				#endif
+        #else
+            {
+                ( void ) pxEarliest;
+            }
+        #endif /* configUSE_PREEMPTION */
+
+        return xSwitchRequired;
     }
-}
+
+#endif /* configUSE_EDF_BATCH_RELEASE */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_EDF_TIMING_WHEEL == 1 )
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    static void prvTimingWheelInsert( TCB_t * pxTCB,
+                                      const TickType_t xNextTick )
     {
-        /* The idle task exists in addition to the application tasks. */
-        const UBaseType_t uxNonApplicationTasks = 1;
-        eSleepModeStatus eReturn = eStandardSleep;
-
-        /* This function must be called from a critical section. */
+        TickType_t xSlotTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+        TickType_t xDelta = xSlotTime - xNextTick;
+        UBaseType_t uxLevel = 0U;
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-        {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xYieldPending != pdFALSE )
+        if( xDelta == portMAX_DELAY )
         {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            /* The wake time is the current tick, from a block time of 0.  The
+             * delayed list releases such a task at the next tick. */
+            xSlotTime = xNextTick;
+            xDelta = ( TickType_t ) 0U;
         }
-        else if( xPendedTicks != 0 )
+        else
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
+            mtCOVERAGE_TEST_MARKER();
         }
-        else
+
+        /* A task goes in the lowest level whose slots reach its wake time.  A
+         * slot of level l is moved down when the tick count reaches the start
+         * of its span, which is after xNextTick and no later than the wake
+         * time, so every task reaches level 0 exactly at its wake time. */
+        while( ( xDelta >> configEDF_TIMING_WHEEL_BITS ) != ( TickType_t ) 0U )
         {
-            /* If all the tasks are in the suspended list (which might mean they
-             * have an infinite block time rather than actually being suspended)
-             * then it is safe to turn all clocks off and just wait for external
-             * interrupts. */
-            if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            if( uxLevel == ( UBaseType_t ) ( configEDF_TIMING_WHEEL_LEVELS - 1 ) )
             {
-                eReturn = eNoTasksWaitingTimeout;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                /* Beyond the span of the wheel.  The task waits in the last
+                 * slot of the top level, and is placed again when that slot is
+                 * moved down. */
+                xSlotTime = xNextTick + ( ( taskEDF_WHEEL_MASK << taskEDF_WHEEL_SHIFT( uxLevel ) ) |
+                                          ( ( ( TickType_t ) 1U << taskEDF_WHEEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) );
+                break;
             }
+
+            xDelta >>= configEDF_TIMING_WHEEL_BITS;
+            uxLevel++;
         }
 
-        return eReturn;
+        listINSERT_END( &( xTimingWheelEDF[ uxLevel ][ ( xSlotTime >> taskEDF_WHEEL_SHIFT( uxLevel ) ) & taskEDF_WHEEL_MASK ] ), &( pxTCB->xStateListItem ) );
     }
-
-#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    static BaseType_t prvTimingWheelTick( const TickType_t xTickNow )
     {
+        List_t * pxSlot;
         TCB_t * pxTCB;
+        UBaseType_t uxLevel;
+        BaseType_t xSwitchRequired = pdFALSE;
 
-        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        /* When the tick count reaches the start of the span of a slot of
+         * level l, which needs the bits of all the levels below to be 0, the
+         * tasks in that slot are placed again in the levels below. */
+        for( uxLevel = 1U; uxLevel < ( UBaseType_t ) configEDF_TIMING_WHEEL_LEVELS; uxLevel++ )
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
-        }
-    }
+            if( ( xTickNow & ( ( ( TickType_t ) 1U << taskEDF_WHEEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+            {
+                break;
+            }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+            pxSlot = &( xTimingWheelEDF[ uxLevel ][ ( xTickNow >> taskEDF_WHEEL_SHIFT( uxLevel ) ) & taskEDF_WHEEL_MASK ] );
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvTimingWheelInsert( pxTCB, xTickNow );
+            }
+        }
 
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
-    {
-        void * pvReturn = NULL;
-        TCB_t * pxTCB;
+        /* Every task in the level 0 slot of this tick is due now. */
+        pxSlot = &( xTimingWheelEDF[ 0 ][ xTickNow & taskEDF_WHEEL_MASK ] );
 
-        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
-        {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
-        }
-        else
+        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
         {
-            pvReturn = NULL;
-        }
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            configASSERT( taskEDF_TIME_BEFORE( xTickNow, listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) ) == pdFALSE );
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
-        return pvReturn;
-    }
+            /* Is the task waiting on an event also?  If so remove it from the
+             * event list. */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+            traceEDF_TASK_RELEASED( pxTCB );
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+            #if ( configUSE_EDF_BATCH_RELEASE == 1 )
+                {
+                    prvAddTaskToReleaseBatch( pxTCB );
+                }
+            #else
+                {
+                    prvAddWokenTaskToReadyList( pxTCB );
 
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
-    {
-        TCB_t * pxTCB;
+                    #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif /* configUSE_PREEMPTION */
+                }
+            #endif /* configUSE_EDF_BATCH_RELEASE */
+        }
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+        #if ( configUSE_EDF_BATCH_RELEASE == 1 )
+            {
+                xSwitchRequired = prvEDFReleaseBatch();
+            }
+        #endif
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+        return xSwitchRequired;
     }
-
-#endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+    #if ( configUSE_TICKLESS_IDLE != 0 )
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
-    {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+        static TickType_t prvTimingWheelNextEvent( void )
+        {
+            const TickType_t xNextTick = xTickCount + ( TickType_t ) 1U;
+            TickType_t xEarliest = portMAX_DELAY; /* Ticks from xNextTick to the earliest event found. */
+            TickType_t xStep, xTime;
+            UBaseType_t uxLevel, uxSlot;
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
-		
-		/********************************************************************************
-		 ***************	 EDF modification: Initialise EDF ready list	 ****************
-		 ********************************************************************************/
-		#if ( configUSE_EDF_SCHEDULER == 1 )
-				{
-						vListInitialise( &xReadyTasksListEDF );
-			  }
-		#endif
+            /* A level 0 slot is due at its tick, a slot of a higher level when
+             * the tick count reaches the start of its span.  Only the slot
+             * heads are read, so this costs at most one look at each slot. */
+            for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configEDF_TIMING_WHEEL_LEVELS; uxLevel++ )
+            {
+                xStep = ( TickType_t ) 1U << taskEDF_WHEEL_SHIFT( uxLevel );
+                xTime = ( xNextTick + xStep - ( TickType_t ) 1U ) & ~( xStep - ( TickType_t ) 1U );
 
-    #if ( INCLUDE_vTaskDelete == 1 )
-        {
-            vListInitialise( &xTasksWaitingTermination );
-        }
-    #endif /* INCLUDE_vTaskDelete */
+                for( uxSlot = 0U; uxSlot < ( UBaseType_t ) taskEDF_WHEEL_SLOTS; uxSlot++ )
+                {
+                    if( ( TickType_t ) ( xTime - xNextTick ) >= xEarliest )
+                    {
+                        break;
+                    }
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-        {
-            vListInitialise( &xSuspendedTaskList );
+                    if( listLIST_IS_EMPTY( &( xTimingWheelEDF[ uxLevel ][ ( xTime >> taskEDF_WHEEL_SHIFT( uxLevel ) ) & taskEDF_WHEEL_MASK ] ) ) == pdFALSE )
+                    {
+                        xEarliest = xTime - xNextTick;
+                        break;
+                    }
+
+                    xTime += xStep;
+                }
+            }
+
+            if( ( xEarliest == portMAX_DELAY ) || ( ( TickType_t ) ( xNextTick + xEarliest ) < xTickCount ) )
+            {
+                /* Nothing to do before the tick count overflows, which is as far
+                 * as the delayed lists let the tick be suppressed too. */
+                xTime = portMAX_DELAY;
+            }
+            else
+            {
+                xTime = xNextTick + xEarliest;
+            }
+
+            return xTime;
         }
-    #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+    #endif /* configUSE_TICKLESS_IDLE */
+
+#endif /* configUSE_EDF_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckTasksWaitingTermination( void )
@@ -4142,7 +7283,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
     {
@@ -4165,7 +7306,23 @@ static void prvCheckTasksWaitingTermination( void )
             {
                 /* The task can only have been allocated dynamically - free both
                  * the stack and TCB. */
-                vPortFreeStack( pxTCB->pxStack );
+                #if ( configUSE_EDF_SHARED_STACK == 1 )
+                    {
+                        /* Except for the shared stack of a job. */
+                        if( pxTCB->pxStack != xSharedStackEDF )
+                        {
+                            vPortFreeStack( pxTCB->pxStack );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #else
+                    {
+                        vPortFreeStack( pxTCB->pxStack );
+                    }
+                #endif
                 vPortFree( pxTCB );
             }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
@@ -4197,27 +7354,38 @@ static void prvCheckTasksWaitingTermination( void )
         #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* ( INCLUDE_vTaskDelete == 1 ) || ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_READY_HEAP == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 static void prvResetNextTaskUnblockTime( void )
 {
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
-    }
+    #if ( configUSE_EDF_TIMING_WHEEL == 1 )
+        {
+            /* The delayed lists are not used.  The tick interrupt processes
+             * the timing wheel on every tick, and prvGetExpectedIdleTime()
+             * looks for its next event before the tick is suppressed. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+    #else
+        {
+            if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+            {
+                /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+                 * the maximum possible value so it is  extremely unlikely that the
+                 * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+                 * there is an item in the delayed list. */
+                xNextTaskUnblockTime = portMAX_DELAY;
+            }
+            else
+            {
+                /* The new current delayed list is not empty, get the value of
+                 * the item at the head of the delayed list.  This is the time at
+                 * which the task at the head of the delayed list should be removed
+                 * from the Blocked state. */
+                xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+            }
+        }
+    #endif /* configUSE_EDF_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -4266,7 +7434,7 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
     {
@@ -4353,10 +7521,10 @@ static void prvResetNextTaskUnblockTime( void )
         return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
     {
@@ -4433,10 +7601,10 @@ static void prvResetNextTaskUnblockTime( void )
         return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                               UBaseType_t uxHighestPriorityWaitingTask )
@@ -4539,7 +7707,158 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+	/************************************************************************************
+	 ***********	 EDF modification: Deadline inheritance for mutex holders	 ************
+	 ************************************************************************************/
+
+    /* All EDF tasks share one priority, so the priority inheritance above would
+     * never trigger.  Instead a mutex holder inherits the deadline of a task
+     * that blocks on the mutex when it is earlier than its own, and is moved
+     * in the ready queue to match.  It keeps the earliest deadline inherited
+     * until it has given back every mutex it holds, the same simplification
+     * the priority inheritance makes. */
+
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        const TickType_t xDeadline = taskEDF_DEADLINE( pxCurrentTCB );
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxMutexHolder != NULL )
+        {
+            if( taskEDF_TIME_BEFORE( xDeadline, taskEDF_READY_DEADLINE( pxMutexHolderTCB ) ) != pdFALSE )
+            {
+                pxMutexHolderTCB->xInheritedDeadline = xDeadline;
+                pxMutexHolderTCB->xDeadlineInherited = pdTRUE;
+
+                /* A ready holder is moved to its new place in the ready
+                 * queue.  Otherwise the deadline applies when it is next made
+                 * ready. */
+                if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    ( void ) prvRemoveTaskFromStateList( pxMutexHolderTCB );
+                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                }
+                else
+                {
+                    /* A holder waiting on another queue or semaphore moves up
+                     * its wait list too. */
+                    pxMutexHolderTCB->xAbsoluteDeadline = xDeadline;
+                    prvEDFEventListReposition( pxMutexHolderTCB );
+                }
+
+                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Inheritance is in effect if the holder runs before its own
+             * deadline because of it, whether now or earlier. */
+            xReturn = taskEDF_TIME_BEFORE( xDeadline, taskEDF_JOB_DEADLINE( pxMutexHolderTCB ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxMutexHolder != NULL )
+        {
+            /* See the comments in the priority inheritance version above. */
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+
+            if( ( pxTCB->xDeadlineInherited != pdFALSE ) && ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 ) )
+            {
+                /* Go back to the deadline of the job.  The task is running so
+                 * it is in the ready queue. */
+                pxTCB->xDeadlineInherited = pdFALSE;
+                traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+                ( void ) prvRemoveTaskFromStateList( pxTCB );
+                prvAddTaskToReadyList( pxTCB );
+
+                /* The task woken by giving the mutex, or one with a deadline
+                 * between the two, may now come first. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+        if( pxMutexHolder != NULL )
+        {
+            configASSERT( pxTCB->uxMutexesHeld );
+
+            /* queue.c reports the waiting tasks by priority, which under EDF
+             * only tells whether any are left.  While some are the holder
+             * keeps the inherited deadline, which may be earlier than needed
+             * but never lets the inversion grow.  Once none are left it goes
+             * back to the deadline of its job, if this is the only mutex it
+             * holds. */
+            if( ( uxHighestPriorityWaitingTask == tskIDLE_PRIORITY ) &&
+                ( pxTCB->xDeadlineInherited != pdFALSE ) &&
+                ( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld ) )
+            {
+                configASSERT( pxTCB != pxCurrentTCB );
+
+                pxTCB->xDeadlineInherited = pdFALSE;
+                traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+
+                if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    ( void ) prvRemoveTaskFromStateList( pxTCB );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    pxTCB->xAbsoluteDeadline = taskEDF_JOB_DEADLINE( pxTCB );
+                    prvEDFEventListReposition( pxTCB );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
@@ -4632,6 +7951,49 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    static char * prvWriteRunTimeToBuffer( char * pcBuffer,
+                                           configRUN_TIME_COUNTER_TYPE ulRunTime )
+    {
+        /* Split into groups of nine digits, which both fit in 32 bits for
+         * any counter below 2^32 * 10^9. */
+        const unsigned long ulHigh = ( unsigned long ) ( ulRunTime / ( configRUN_TIME_COUNTER_TYPE ) 1000000000UL );
+        const unsigned long ulLow = ( unsigned long ) ( ulRunTime % ( configRUN_TIME_COUNTER_TYPE ) 1000000000UL );
+
+        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+            {
+                if( ulHigh > 0UL )
+                {
+                    sprintf( pcBuffer, "\t%lu%09lu", ulHigh, ulLow );
+                }
+                else
+                {
+                    sprintf( pcBuffer, "\t%lu", ulLow );
+                }
+            }
+        #else
+            {
+                /* sizeof( int ) == sizeof( long ) so a smaller printf() library
+                 * can be used. */
+                if( ulHigh > 0UL )
+                {
+                    sprintf( pcBuffer, "\t%u%09u", ( unsigned int ) ulHigh, ( unsigned int ) ulLow ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                }
+                else
+                {
+                    sprintf( pcBuffer, "\t%u", ( unsigned int ) ulLow ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                }
+            }
+        #endif
+
+        /* Return the new end of string. */
+        return pcBuffer + strlen( pcBuffer );
+    }
+
+#endif /* ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
     void vTaskList( char * pcWriteBuffer )
@@ -4640,6 +8002,10 @@ static void prvResetNextTaskUnblockTime( void )
         UBaseType_t uxArraySize, x;
         char cStatus;
 
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            EDFTaskStatus_t * pxEDFStatusArray;
+        #endif
+
         /*
          * PLEASE NOTE:
          *
@@ -4651,7 +8017,9 @@ static void prvResetNextTaskUnblockTime( void )
          * uxTaskGetSystemState() output into a human readable table that
          * displays task: names, states, priority, stack usage and task number.
          * Stack usage specified as the number of unused StackType_t words stack can hold
-         * on top of stack - not the number of bytes.
+         * on top of stack - not the number of bytes.  With the EDF scheduler each
+         * line goes on with the period, the absolute deadline and the number of
+         * deadline misses of the task, from uxTaskGetEDFSystemState().
          *
          * vTaskList() has a dependency on the sprintf() C library function that
          * might bloat the code size, use a lot of stack, and provide different
@@ -4679,10 +8047,38 @@ static void prvResetNextTaskUnblockTime( void )
          * equate to NULL. */
         pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
 
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                pxEDFStatusArray = pvPortMalloc( uxArraySize * sizeof( EDFTaskStatus_t ) ); /*lint !e9079 As above. */
+
+                if( ( pxEDFStatusArray == NULL ) && ( pxTaskStatusArray != NULL ) )
+                {
+                    vPortFree( pxTaskStatusArray );
+                    pxTaskStatusArray = NULL;
+                }
+                else if( ( pxEDFStatusArray != NULL ) && ( pxTaskStatusArray == NULL ) )
+                {
+                    vPortFree( pxEDFStatusArray );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_EDF_SCHEDULER */
+
         if( pxTaskStatusArray != NULL )
         {
             /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    uxArraySize = uxTaskGetEDFSystemState( pxTaskStatusArray, pxEDFStatusArray, uxArraySize, NULL );
+                }
+            #else
+                {
+                    uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+                }
+            #endif
 
             /* Create a human readable table from the binary data. */
             for( x = 0; x < uxArraySize; x++ )
@@ -4721,13 +8117,28 @@ static void prvResetNextTaskUnblockTime( void )
                 pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
                 /* Write the rest of the string. */
-                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber,
+                                 ( unsigned int ) pxEDFStatusArray[ x ].xPeriod, ( unsigned int ) pxEDFStatusArray[ x ].xAbsoluteDeadline, ( unsigned int ) pxEDFStatusArray[ x ].uxDeadlineMisses ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    }
+                #else
+                    {
+                        sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    }
+                #endif
                 pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
             }
 
             /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
              * is 0 then vPortFree() will be #defined to nothing. */
             vPortFree( pxTaskStatusArray );
+
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    vPortFree( pxEDFStatusArray );
+                }
+            #endif
         }
         else
         {
@@ -4813,17 +8224,21 @@ static void prvResetNextTaskUnblockTime( void )
                      * easily. */
                     pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
+                    /* The counter may be wider than any type printf()
+                     * can print here, so it is written separately. */
+                    pcWriteBuffer = prvWriteRunTimeToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].ulRunTimeCounter );
+
                     if( ulStatsAsPercentage > 0UL )
                     {
                         #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
                             {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                                sprintf( pcWriteBuffer, "\t\t%lu%%\r\n", ( unsigned long ) ulStatsAsPercentage );
                             }
                         #else
                             {
                                 /* sizeof( int ) == sizeof( long ) so a smaller
                                  * printf() library can be used. */
-                                sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                                sprintf( pcWriteBuffer, "\t\t%u%%\r\n", ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
                             }
                         #endif
                     }
@@ -4831,17 +8246,7 @@ static void prvResetNextTaskUnblockTime( void )
                     {
                         /* If the percentage is zero here then the task has
                          * consumed less than 1% of the total run time. */
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                            {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-                            }
-                        #else
-                            {
-                                /* sizeof( int ) == sizeof( long ) so a smaller
-                                 * printf() library can be used. */
-                                sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                            }
-                        #endif
+                        sprintf( pcWriteBuffer, "\t\t<1%%\r\n" ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
                     }
 
                     pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
@@ -5132,7 +8537,7 @@ TickType_t uxTaskResetEventItemValue( void )
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                prvAddTaskToReadyList( pxTCB );
+                prvAddWokenTaskToReadyList( pxTCB );
 
                 /* The task should not have been on an event list. */
                 configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
@@ -5153,7 +8558,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 0 )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #else
+                    if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5279,7 +8688,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    prvAddWokenTaskToReadyList( pxTCB );
                 }
                 else
                 {
@@ -5288,7 +8697,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 0 )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #else
+                    if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5370,7 +8783,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    prvAddWokenTaskToReadyList( pxTCB );
                 }
                 else
                 {
@@ -5379,7 +8792,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 0 )
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #else
+                    if( taskEDF_PREEMPTS_CURRENT( pxTCB ) )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5510,6 +8927,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     TickType_t xTimeToWake;
     const TickType_t xConstTickCount = xTickCount;
 
+    #if ( configUSE_EDF_SRP == 1 )
+        {
+            /* A task that blocks while it holds an SRP resource would keep
+             * the system ceiling raised and could deadlock the tasks it holds
+             * back. */
+            configASSERT( pxCurrentTCB->uxSRPResourcesHeld == ( UBaseType_t ) 0U );
+        }
+    #endif
+
+    #if ( configUSE_EDF_SHARED_STACK == 1 )
+        {
+            /* A job on the shared stack runs to completion.  If it blocked,
+             * the jobs started while it waits would be placed over its frame. */
+            configASSERT( pxCurrentTCB->xJobOnStack == pdFALSE );
+        }
+    #endif
+
     #if ( INCLUDE_xTaskAbortDelay == 1 )
         {
             /* About to enter a delayed list, so ensure the ucDelayAborted flag is
@@ -5521,7 +8955,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    if( prvRemoveTaskFromStateList( pxCurrentTCB ) == ( UBaseType_t ) 0 )
     {
         /* The current task must be in a ready list, so there is no need to
          * check, and the port reset macro can be called directly. */
@@ -5551,30 +8985,38 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 /* The list item will be inserted in wake time order. */
                 listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-                if( xTimeToWake < xConstTickCount )
-                {
-                    /* Wake time has overflowed.  Place this item in the overflow
-                     * list. */
-                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-                }
-                else
-                {
-                    /* The wake time has not overflowed, so the current block list
-                     * is used. */
-                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-                    /* If the task entering the blocked state was placed at the
-                     * head of the list of blocked tasks then xNextTaskUnblockTime
-                     * needs to be updated too. */
-                    if( xTimeToWake < xNextTaskUnblockTime )
+                #if ( configUSE_EDF_TIMING_WHEEL == 1 )
                     {
-                        xNextTaskUnblockTime = xTimeToWake;
+                        prvTimingWheelInsert( pxCurrentTCB, xConstTickCount + ( TickType_t ) 1 );
                     }
-                    else
+                #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        if( xTimeToWake < xConstTickCount )
+                        {
+                            /* Wake time has overflowed.  Place this item in the overflow
+                             * list. */
+                            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                        }
+                        else
+                        {
+                            /* The wake time has not overflowed, so the current block list
+                             * is used. */
+                            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                            /* If the task entering the blocked state was placed at the
+                             * head of the list of blocked tasks then xNextTaskUnblockTime
+                             * needs to be updated too. */
+                            if( xTimeToWake < xNextTaskUnblockTime )
+                            {
+                                xNextTaskUnblockTime = xTimeToWake;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
                     }
-                }
+                #endif /* configUSE_EDF_TIMING_WHEEL */
             }
         }
     #else /* INCLUDE_vTaskSuspend */
@@ -5587,28 +9029,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            if( xTimeToWake < xConstTickCount )
-            {
-                /* Wake time has overflowed.  Place this item in the overflow list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-            }
-            else
-            {
-                /* The wake time has not overflowed, so the current block list is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-                /* If the task entering the blocked state was placed at the head of the
-                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-                 * too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+            #if ( configUSE_EDF_TIMING_WHEEL == 1 )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    prvTimingWheelInsert( pxCurrentTCB, xConstTickCount + ( TickType_t ) 1 );
                 }
-                else
+            #else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    if( xTimeToWake < xConstTickCount )
+                    {
+                        /* Wake time has overflowed.  Place this item in the overflow list. */
+                        vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                    }
+                    else
+                    {
+                        /* The wake time has not overflowed, so the current block list is used. */
+                        vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                        /* If the task entering the blocked state was placed at the head of the
+                         * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                         * too. */
+                        if( xTimeToWake < xNextTaskUnblockTime )
+                        {
+                            xNextTaskUnblockTime = xTimeToWake;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
                 }
-            }
+            #endif /* configUSE_EDF_TIMING_WHEEL */
 
             /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
             ( void ) xCanBlockIndefinitely;
@@ -0,0 +1,415 @@
+/*
+ * EDF schedulability analyser for constrained deadline task sets.
+ *
+ * Host tool, not part of the target build.  Build and run with:
+ *
+ *     cc -O2 -o edf_qpa tools/edf_qpa.c
+ *     ./edf_qpa tools/edf_tasks.csv
+ *
+ * The task table has one task per line:
+ *
+ *     name, wcet, period, deadline, offset
+ *
+ * All times are integers in the same unit (ticks, or microseconds when the
+ * execution times are shorter than a tick).  A deadline of 0 means the
+ * deadline equals the period, as with xTaskPeriodicCreateConstrained().  Empty
+ * lines and lines starting with '#' are ignored.
+ *
+ * The set is tested with QPA (Quick Processor-demand Analysis, Zhang and
+ * Burns 2009), which is exact for synchronous release.  Offsets are read but
+ * ignored: releasing every task together is the worst case, so a set that
+ * passes here also passes with any offsets.
+ *
+ * Exit status is 0 if the set is schedulable, 1 if it is not, 2 on an input
+ * error.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define qpaMAX_NAME_LEN     32
+#define qpaMAX_LINE_LEN     256
+
+typedef struct QPATask
+{
+    char pcName[ qpaMAX_NAME_LEN ];
+    uint64_t ullWcet;
+    uint64_t ullPeriod;
+    uint64_t ullDeadline;
+    uint64_t ullOffset;
+} QPATask_t;
+
+static QPATask_t * pxTasks = NULL;
+static size_t uxNumTasks = 0;
+static size_t uxMaxTasks = 0;
+
+/*-----------------------------------------------------------*/
+
+static char * prvTrim( char * pcString )
+{
+    char * pcEnd;
+
+    while( isspace( ( unsigned char ) *pcString ) )
+    {
+        pcString++;
+    }
+
+    pcEnd = pcString + strlen( pcString );
+
+    while( ( pcEnd > pcString ) && isspace( ( unsigned char ) pcEnd[ -1 ] ) )
+    {
+        pcEnd--;
+    }
+
+    *pcEnd = '\0';
+
+    return pcString;
+}
+/*-----------------------------------------------------------*/
+
+static int prvParseTime( char * pcField,
+                         uint64_t * pullValue )
+{
+    char * pcEnd;
+
+    pcField = prvTrim( pcField );
+    *pullValue = strtoull( pcField, &pcEnd, 10 );
+
+    return ( ( *pcField != '\0' ) && ( *pcEnd == '\0' ) && ( *pcField != '-' ) );
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadTaskTable( FILE * pxFile,
+                             const char * pcFileName )
+{
+    char pcLine[ qpaMAX_LINE_LEN ];
+    char * pcFields[ 5 ];
+    char * pcCursor;
+    unsigned long ulLine = 0;
+    size_t uxField;
+    QPATask_t * pxTask;
+
+    while( fgets( pcLine, sizeof( pcLine ), pxFile ) != NULL )
+    {
+        ulLine++;
+        pcCursor = prvTrim( pcLine );
+
+        if( ( *pcCursor == '\0' ) || ( *pcCursor == '#' ) )
+        {
+            continue;
+        }
+
+        for( uxField = 0; uxField < 5; uxField++ )
+        {
+            pcFields[ uxField ] = pcCursor;
+            pcCursor = strchr( pcCursor, ',' );
+
+            if( pcCursor == NULL )
+            {
+                break;
+            }
+
+            *pcCursor++ = '\0';
+        }
+
+        if( uxField != 4 )
+        {
+            fprintf( stderr, "%s:%lu: expected name, wcet, period, deadline, offset\n", pcFileName, ulLine );
+            return 0;
+        }
+
+        if( uxNumTasks == uxMaxTasks )
+        {
+            uxMaxTasks = ( uxMaxTasks == 0 ) ? 64 : ( uxMaxTasks * 2 );
+            pxTasks = realloc( pxTasks, uxMaxTasks * sizeof( QPATask_t ) );
+
+            if( pxTasks == NULL )
+            {
+                fprintf( stderr, "out of memory\n" );
+                return 0;
+            }
+        }
+
+        pxTask = &pxTasks[ uxNumTasks ];
+        snprintf( pxTask->pcName, sizeof( pxTask->pcName ), "%s", prvTrim( pcFields[ 0 ] ) );
+
+        if( !prvParseTime( pcFields[ 1 ], &pxTask->ullWcet ) ||
+            !prvParseTime( pcFields[ 2 ], &pxTask->ullPeriod ) ||
+            !prvParseTime( pcFields[ 3 ], &pxTask->ullDeadline ) ||
+            !prvParseTime( pcFields[ 4 ], &pxTask->ullOffset ) )
+        {
+            fprintf( stderr, "%s:%lu: times must be non-negative integers\n", pcFileName, ulLine );
+            return 0;
+        }
+
+        if( pxTask->ullDeadline == 0 )
+        {
+            pxTask->ullDeadline = pxTask->ullPeriod;
+        }
+
+        if( ( pxTask->ullPeriod == 0 ) || ( pxTask->ullDeadline > pxTask->ullPeriod ) )
+        {
+            fprintf( stderr, "%s:%lu: %s: period must be non-zero and deadline must not exceed it\n", pcFileName, ulLine, pxTask->pcName );
+            return 0;
+        }
+
+        uxNumTasks++;
+    }
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
+
+/* Processor demand h(t): the execution time of all the jobs that are released
+ * and have their deadline within [ 0, t ]. */
+static uint64_t prvDemand( uint64_t ullTime )
+{
+    uint64_t ullDemand = 0;
+    size_t x;
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        if( ullTime >= pxTasks[ x ].ullDeadline )
+        {
+            ullDemand += ( ( ( ullTime - pxTasks[ x ].ullDeadline ) / pxTasks[ x ].ullPeriod ) + 1 ) * pxTasks[ x ].ullWcet;
+        }
+    }
+
+    return ullDemand;
+}
+/*-----------------------------------------------------------*/
+
+/* The latest absolute deadline strictly before ullTime, or 0 if there is
+ * none. */
+static uint64_t prvLastDeadlineBefore( uint64_t ullTime )
+{
+    uint64_t ullLatest = 0;
+    uint64_t ullDeadline;
+    size_t x;
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        if( ullTime > pxTasks[ x ].ullDeadline )
+        {
+            ullDeadline = ( ( ( ullTime - pxTasks[ x ].ullDeadline - 1 ) / pxTasks[ x ].ullPeriod ) * pxTasks[ x ].ullPeriod ) + pxTasks[ x ].ullDeadline;
+
+            if( ullDeadline > ullLatest )
+            {
+                ullLatest = ullDeadline;
+            }
+        }
+    }
+
+    return ullLatest;
+}
+/*-----------------------------------------------------------*/
+
+/* Plain QPA over the absolute deadlines up to ullLimit, walking them down from
+ * the latest.  When h(t) < t no deadline in [ h(t), t ) can fail, so it jumps
+ * straight to h(t).  Returns the latest deadline d up to ullLimit with
+ * h(d) > d, or 0 if there is none. */
+static uint64_t prvLatestFailure( uint64_t ullLimit,
+                                  uint64_t ullMinDeadline )
+{
+    uint64_t ullTime = prvLastDeadlineBefore( ullLimit + 1 );
+    uint64_t ullDemand = prvDemand( ullTime );
+
+    while( ( ullDemand > ullMinDeadline ) && ( ullDemand <= ullTime ) )
+    {
+        if( ullDemand < ullTime )
+        {
+            ullTime = ullDemand;
+        }
+        else
+        {
+            ullTime = prvLastDeadlineBefore( ullTime );
+        }
+
+        ullDemand = prvDemand( ullTime );
+    }
+
+    if( ullDemand <= ullTime )
+    {
+        return 0;
+    }
+
+    /* A jump can end between deadlines, h(t) is the same at the deadline
+     * before. */
+    return prvLastDeadlineBefore( ullTime + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/* Length of the synchronous busy period, which bounds the interval that has
+ * to be checked.  Only called when the utilisation is at most 1, so the
+ * iteration converges. */
+static uint64_t prvBusyPeriod( void )
+{
+    uint64_t ullLength = 0;
+    uint64_t ullNext = 0;
+    size_t x;
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        ullNext += pxTasks[ x ].ullWcet;
+    }
+
+    while( ullNext != ullLength )
+    {
+        ullLength = ullNext;
+        ullNext = 0;
+
+        for( x = 0; x < uxNumTasks; x++ )
+        {
+            ullNext += ( ( ullLength + pxTasks[ x ].ullPeriod - 1 ) / pxTasks[ x ].ullPeriod ) * pxTasks[ x ].ullWcet;
+        }
+    }
+
+    return ullLength;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    FILE * pxFile;
+    double dUtilisation = 0.0;
+    double dBound = 0.0;
+    const char * pcBound = "synchronous busy period";
+    uint64_t ullInterval;
+    uint64_t ullGRSBound;
+    uint64_t ullMinDeadline = UINT64_MAX;
+    uint64_t ullTime;
+    uint64_t ullLow;
+    uint64_t ullMiddle;
+    uint64_t ullFailTime;
+    size_t x;
+
+    if( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <task table>\n", argv[ 0 ] );
+        return 2;
+    }
+
+    pxFile = fopen( argv[ 1 ], "r" );
+
+    if( pxFile == NULL )
+    {
+        perror( argv[ 1 ] );
+        return 2;
+    }
+
+    if( !prvReadTaskTable( pxFile, argv[ 1 ] ) )
+    {
+        fclose( pxFile );
+        return 2;
+    }
+
+    fclose( pxFile );
+
+    if( uxNumTasks == 0 )
+    {
+        printf( "PASS: no tasks\n" );
+        return 0;
+    }
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        dUtilisation += ( double ) pxTasks[ x ].ullWcet / ( double ) pxTasks[ x ].ullPeriod;
+
+        if( pxTasks[ x ].ullDeadline < ullMinDeadline )
+        {
+            ullMinDeadline = pxTasks[ x ].ullDeadline;
+        }
+    }
+
+    printf( "%zu tasks, utilisation %.4f\n", uxNumTasks, dUtilisation );
+
+    if( dUtilisation > 1.0 )
+    {
+        printf( "FAIL: utilisation above 1\n" );
+        return 1;
+    }
+
+    /* Only the interval [ 0, L ] has to be checked, L being the shorter of
+     * the synchronous busy period and, when U < 1, the bound of George,
+     * Rivierre and Spuri. */
+    ullInterval = prvBusyPeriod();
+
+    if( dUtilisation < 1.0 )
+    {
+        for( x = 0; x < uxNumTasks; x++ )
+        {
+            dBound += ( double ) ( pxTasks[ x ].ullPeriod - pxTasks[ x ].ullDeadline ) * ( ( double ) pxTasks[ x ].ullWcet / ( double ) pxTasks[ x ].ullPeriod );
+        }
+
+        /* The max( D - T ) term of the bound is never positive as deadlines
+         * are constrained. */
+        dBound /= ( 1.0 - dUtilisation );
+
+        /* Round up so the bound is never shortened by the conversion.  It is 0
+         * when every deadline equals its period, then no interval has to be
+         * checked. */
+        ullGRSBound = ( dBound > 0.0 ) ? ( ( uint64_t ) dBound + 1 ) : 0;
+
+        if( ullGRSBound < ullInterval )
+        {
+            ullInterval = ullGRSBound;
+            pcBound = "bound of George, Rivierre and Spuri";
+        }
+    }
+
+    ullFailTime = prvLatestFailure( ullInterval, ullMinDeadline );
+
+    if( ullFailTime == 0 )
+    {
+        if( ullInterval < ullMinDeadline )
+        {
+            printf( "PASS: no deadline within the %s of %" PRIu64 "\n", pcBound, ullInterval );
+        }
+        else
+        {
+            printf( "PASS: demand fits in every interval up to the %s of %" PRIu64 "\n", pcBound, ullInterval );
+        }
+
+        return 0;
+    }
+
+    /* QPA stops at the latest failing deadline.  Whether some deadline up to
+     * t fails can only change from no to yes as t grows, so the earliest one
+     * is found by bisection, with a QPA run below each failure found.  No
+     * deadline before ullLow fails. */
+    ullLow = 0;
+
+    while( ullLow < ullFailTime )
+    {
+        ullMiddle = ullLow + ( ( ullFailTime - ullLow ) / 2 );
+        ullTime = prvLatestFailure( ullMiddle, ullMinDeadline );
+
+        if( ullTime != 0 )
+        {
+            ullFailTime = ullTime;
+        }
+        else
+        {
+            ullLow = ullMiddle + 1;
+        }
+    }
+
+    printf( "FAIL: first failing interval [ 0, %" PRIu64 " ] has demand %" PRIu64 "\n", ullFailTime, prvDemand( ullFailTime ) );
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        if( ullFailTime >= pxTasks[ x ].ullDeadline )
+        {
+            printf( "    %-*s %" PRIu64 " jobs\n", qpaMAX_NAME_LEN, pxTasks[ x ].pcName, ( ( ullFailTime - pxTasks[ x ].ullDeadline ) / pxTasks[ x ].ullPeriod ) + 1 );
+        }
+    }
+
+    return 1;
+}
@@ -0,0 +1,56 @@
+/*
+ * Kernel configuration of the host simulations in this directory.  The
+ * scheduler options follow the target FreeRTOSConfig.h.  The ones a simulation
+ * may change can be overridden on the command line or before tasks.c is
+ * included.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION					1
+#define configUSE_IDLE_HOOK						0
+#define configUSE_TICK_HOOK						0
+#define configCPU_CLOCK_HZ						( ( unsigned long ) 60000000 )
+#define configTICK_RATE_HZ						( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES					( 4 )
+#define configMINIMAL_STACK_SIZE				( ( unsigned short ) 90 )
+#define configMAX_TASK_NAME_LEN					( 20 )
+#define configUSE_TRACE_FACILITY				0
+#define configUSE_16_BIT_TICKS					0
+#define configIDLE_SHOULD_YIELD					1
+#define configQUEUE_REGISTRY_SIZE				0
+#define configUSE_CO_ROUTINES					0
+#define configSUPPORT_DYNAMIC_ALLOCATION		1
+#define configSUPPORT_STATIC_ALLOCATION			0
+
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+
+/* Tickless idle, see vPortSuppressTicksAndSleep() in edf_tickless.c. */
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE				1
+#endif
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP	2
+
+/*EDF Scheduler options */
+
+#define configUSE_EDF_SCHEDULER		1
+#ifndef configUSE_EDF_READY_HEAP
+	#define configUSE_EDF_READY_HEAP	0
+#endif
+#define configEDF_MAX_READY_TASKS	( 1024 )
+
+#ifndef configUSE_EDF_TIMING_WHEEL
+	#define configUSE_EDF_TIMING_WHEEL	0
+#endif
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
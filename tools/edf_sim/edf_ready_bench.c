@@ -0,0 +1,172 @@
+/*
+ * Cost of readying and removing a task with each EDF ready queue backend.
+ *
+ * Host tool, not part of the target build.  N periodic tasks with random
+ * periods are made ready.  A task is then taken out of the ready queue with
+ * prvRemoveTaskFromStateList() and put back at a later deadline with
+ * prvAddTaskToReadyList(), many times over, so the queue always holds N tasks.
+ * This is done first with the task at the head of the queue, which moves on by
+ * its period as when the running job completes and the next one is released,
+ * then with any task, which moves to a random deadline within a period of the
+ * head, as when a ready task is suspended and resumed.  Build once for each
+ * backend and run with, FREERTOS being the FreeRTOS kernel source directory:
+ *
+ *     cc -O2 -I tools/edf_sim -I $FREERTOS/include -o ready_bench_list \
+ *         tools/edf_sim/edf_ready_bench.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     cc -O2 -DconfigUSE_EDF_READY_HEAP=1 -I tools/edf_sim -I $FREERTOS/include \
+ *         -o ready_bench_heap tools/edf_sim/edf_ready_bench.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     for n in 8 64 256; do ./ready_bench_list $n; ./ready_bench_heap $n; done
+ *
+ * Times are read with the time stamp counter on x86 hosts, which counts
+ * cycles at the nominal clock, and are in nanoseconds elsewhere.  They include
+ * reading the counter.  Only the ratios between backends and task counts carry
+ * over to the target.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* The scheduler is never started. */
+#define configUSE_TICKLESS_IDLE    0
+
+#include "../../tasks.c"
+
+#include <stdio.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    #include <x86intrin.h>
+    #define benchNOW()    ( ( unsigned long long ) __rdtsc() )
+    #define benchUNIT     "cycles"
+#else
+    #include <time.h>
+    static unsigned long long prvNow( void )
+    {
+        struct timespec xTime;
+
+        clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+        return ( ( unsigned long long ) xTime.tv_sec * 1000000000ULL ) + ( unsigned long long ) xTime.tv_nsec;
+    }
+    #define benchNOW()    prvNow()
+    #define benchUNIT     "ns"
+#endif
+
+#define benchMAX_TASKS    1024
+#define benchPERIOD       ( ( TickType_t ) 1000 ) /* The shortest period, the longest is twice that. */
+#define benchROUNDS       200000UL /* Of each kind, the first tenth warms up and is not counted. */
+
+static TaskHandle_t xHandles[ benchMAX_TASKS ];
+static size_t uxNumTasks = 0;
+static uint32_t ulRandom = 1UL;
+
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvBenchTask, pvParameters )
+{
+    /* Never runs. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    /* Same generator as the C standard example, enough to spread deadlines. */
+    ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+
+    return ( ulRandom >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
+/* Times benchROUNDS removals and insertions.  With xAnyTask at pdFALSE the task
+ * at the head of the ready queue is moved, otherwise any task. */
+static void prvMoveTasks( BaseType_t xAnyTask,
+                          unsigned long long * pullRemove,
+                          unsigned long long * pullInsert )
+{
+    unsigned long long ullStart, ullRemoved, ullInserted;
+    unsigned long ulRound;
+    TickType_t xRelease;
+    TCB_t * pxTCB;
+
+    *pullRemove = 0ULL;
+    *pullInsert = 0ULL;
+
+    for( ulRound = 0UL; ulRound < benchROUNDS; ulRound++ )
+    {
+        pxTCB = taskEDF_HEAD_OF_READY_QUEUE();
+
+        if( xAnyTask == pdFALSE )
+        {
+            pxTCB->xTaskReleaseTime += pxTCB->xTaskPeriod;
+        }
+        else
+        {
+            xRelease = pxTCB->xTaskReleaseTime + ( ( TickType_t ) prvRand() % benchPERIOD );
+            pxTCB = xHandles[ prvRand() % uxNumTasks ];
+            pxTCB->xTaskReleaseTime = xRelease;
+        }
+
+        ullStart = benchNOW();
+        ( void ) prvRemoveTaskFromStateList( pxTCB );
+        ullRemoved = benchNOW();
+        prvAddTaskToReadyList( pxTCB );
+        ullInserted = benchNOW();
+
+        if( ulRound >= ( benchROUNDS / 10UL ) )
+        {
+            *pullRemove += ullRemoved - ullStart;
+            *pullInsert += ullInserted - ullRemoved;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    const unsigned long ulCounted = benchROUNDS - ( benchROUNDS / 10UL );
+    unsigned long long ullRemove, ullInsert;
+    size_t x;
+
+    if( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <number of tasks>\n", argv[ 0 ] );
+        return 2;
+    }
+
+    uxNumTasks = ( size_t ) strtoul( argv[ 1 ], NULL, 10 );
+
+    if( ( uxNumTasks == 0 ) || ( uxNumTasks > benchMAX_TASKS ) )
+    {
+        fprintf( stderr, "the number of tasks must be 1 to %d\n", benchMAX_TASKS );
+        return 2;
+    }
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        if( xTaskPeriodicCreateConstrained( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, &( xHandles[ x ] ),
+                                            benchPERIOD + ( ( TickType_t ) prvRand() % benchPERIOD ), benchPERIOD, ( TickType_t ) 0, ( TickType_t ) 0 ) != pdPASS )
+        {
+            fprintf( stderr, "task %zu not created\n", x );
+            return 2;
+        }
+    }
+
+    /* Spread the first deadlines over a period. */
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        ( void ) prvRemoveTaskFromStateList( xHandles[ x ] );
+        xHandles[ x ]->xTaskReleaseTime = ( TickType_t ) prvRand() % benchPERIOD;
+        prvAddTaskToReadyList( xHandles[ x ] );
+    }
+
+    printf( "%s, %zu tasks, %lu moves of each kind\n", ( configUSE_EDF_READY_HEAP == 1 ) ? "ready heap" : "ready list",
+            uxNumTasks, ulCounted );
+
+    prvMoveTasks( pdFALSE, &ullRemove, &ullInsert );
+    printf( "  head: remove %6llu, insert %6llu %s\n", ullRemove / ulCounted, ullInsert / ulCounted, benchUNIT );
+
+    prvMoveTasks( pdTRUE, &ullRemove, &ullInsert );
+    printf( "  any:  remove %6llu, insert %6llu %s\n", ullRemove / ulCounted, ullInsert / ulCounted, benchUNIT );
+
+    return 0;
+}
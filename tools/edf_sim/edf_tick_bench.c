@@ -0,0 +1,187 @@
+/*
+ * Cost of the tick interrupt when many periodic tasks are released together.
+ *
+ * Host tool, not part of the target build.  N tasks with the same period and
+ * no offset are released by the same tick, as happens on every hyperperiod
+ * boundary.  Every job completes as soon as it runs, with xTaskDelayUntil().
+ * Build once for each delayed task backend and run with, FREERTOS being the
+ * FreeRTOS kernel source directory:
+ *
+ *     cc -O2 -I tools/edf_sim -I $FREERTOS/include -o tick_bench_list \
+ *         tools/edf_sim/edf_tick_bench.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     cc -O2 -DconfigUSE_EDF_TIMING_WHEEL=1 -I tools/edf_sim -I $FREERTOS/include \
+ *         -o tick_bench_wheel tools/edf_sim/edf_tick_bench.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     for n in 16 64 256; do ./tick_bench_list $n; ./tick_bench_wheel $n; done
+ *
+ * xTaskIncrementTick() is timed at every tick and averaged over the periods.
+ * The benchmark reports the release tick, the most expensive of the other
+ * ticks, which with the timing wheel are the ones that move tasks between
+ * levels, and the sum over the whole period.  The blocking call of each job is
+ * timed too.  Readying a task costs O(n) with the sorted EDF ready list, which
+ * hides the delayed task backend at the release; add
+ * -DconfigUSE_EDF_READY_HEAP=1 to measure with the heap, or
+ * -DconfigUSE_EDF_BATCH_RELEASE=1 to merge the released tasks into the list
+ * in one pass.
+ *
+ * Times are read with the time stamp counter on x86 hosts, which counts
+ * cycles at the nominal clock, and are in nanoseconds elsewhere.  Only the
+ * ratios between backends and task counts carry over to the target.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* The idle task never runs, so tickless idle would only add to the tick. */
+#define configUSE_TICKLESS_IDLE    0
+
+#include "../../tasks.c"
+
+#include <stdio.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+    #include <x86intrin.h>
+    #define benchNOW()    ( ( unsigned long long ) __rdtsc() )
+    #define benchUNIT     "cycles"
+#else
+    #include <time.h>
+    static unsigned long long prvNow( void )
+    {
+        struct timespec xTime;
+
+        clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+        return ( ( unsigned long long ) xTime.tv_sec * 1000000000ULL ) + ( unsigned long long ) xTime.tv_nsec;
+    }
+    #define benchNOW()    prvNow()
+    #define benchUNIT     "ns"
+#endif
+
+#define benchMAX_TASKS    1024
+#define benchPERIOD       ( ( TickType_t ) 1000 )
+#define benchPERIODS      51 /* The first one warms up and is not counted. */
+
+static TaskHandle_t xHandles[ benchMAX_TASKS ];
+static TickType_t xLastWakeTimes[ benchMAX_TASKS ];
+static size_t uxNumTasks = 0;
+static unsigned long long ullTickTimes[ benchPERIOD ]; /* Summed over the periods, by tick within the period. */
+
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvBenchTask, pvParameters )
+{
+    /* Never runs, the jobs are played out by prvRunJobs(). */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+/* Completes every ready job.  Returns the time spent blocking and the number
+ * of jobs in *pulJobs. */
+static unsigned long long prvRunJobs( unsigned long * pulJobs )
+{
+    unsigned long long ullTime = 0ULL, ullStart;
+    size_t x;
+
+    *pulJobs = 0UL;
+
+    while( ( TaskHandle_t ) pxCurrentTCB != xIdleTaskHandle )
+    {
+        for( x = 0; xHandles[ x ] != ( TaskHandle_t ) pxCurrentTCB; x++ )
+        {
+        }
+
+        ullStart = benchNOW();
+        ( void ) xTaskDelayUntil( &( xLastWakeTimes[ x ] ), benchPERIOD );
+        ullTime += benchNOW() - ullStart;
+        ( *pulJobs )++;
+    }
+
+    return ullTime;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    unsigned long long ullStart, ullTick, ullBlockTime;
+    unsigned long long ullWorstOther = 0ULL, ullPeriod = 0ULL, ullBlock = 0ULL;
+    unsigned long ulJobs, ulCounted = 0UL;
+    unsigned long ulPeriods, ulTick;
+    size_t x;
+
+    if( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <number of tasks>\n", argv[ 0 ] );
+        return 2;
+    }
+
+    uxNumTasks = ( size_t ) strtoul( argv[ 1 ], NULL, 10 );
+
+    if( ( uxNumTasks == 0 ) || ( uxNumTasks > benchMAX_TASKS ) )
+    {
+        fprintf( stderr, "the number of tasks must be 1 to %d\n", benchMAX_TASKS );
+        return 2;
+    }
+
+    for( x = 0; x < uxNumTasks; x++ )
+    {
+        if( xTaskPeriodicCreateConstrained( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, &( xHandles[ x ] ),
+                                            benchPERIOD, benchPERIOD, ( TickType_t ) 0, ( TickType_t ) 0 ) != pdPASS )
+        {
+            fprintf( stderr, "task %zu not created\n", x );
+            return 2;
+        }
+
+        xLastWakeTimes[ x ] = ( TickType_t ) 0;
+    }
+
+    vTaskStartScheduler();
+
+    for( ulPeriods = 0UL; ulPeriods < benchPERIODS; ulPeriods++ )
+    {
+        for( ulTick = 0UL; ulTick < ( unsigned long ) benchPERIOD; ulTick++ )
+        {
+            ullBlockTime = prvRunJobs( &ulJobs );
+            ullStart = benchNOW();
+
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                ullTick = benchNOW() - ullStart;
+                vTaskSwitchContext();
+            }
+            else
+            {
+                ullTick = benchNOW() - ullStart;
+            }
+
+            if( ulPeriods == 0UL )
+            {
+                continue;
+            }
+
+            ullBlock += ullBlockTime;
+            ulCounted += ulJobs;
+            ullTickTimes[ xTickCount % benchPERIOD ] += ullTick;
+        }
+    }
+
+    ulPeriods = benchPERIODS - 1UL;
+
+    for( ulTick = 0UL; ulTick < ( unsigned long ) benchPERIOD; ulTick++ )
+    {
+        ullPeriod += ullTickTimes[ ulTick ];
+
+        if( ( ulTick != 0UL ) && ( ullTickTimes[ ulTick ] > ullWorstOther ) )
+        {
+            ullWorstOther = ullTickTimes[ ulTick ];
+        }
+    }
+
+    printf( "%s, %s%s, %zu tasks, %lu periods of %lu ticks\n", ( configUSE_EDF_TIMING_WHEEL == 1 ) ? "timing wheel" : "delayed list",
+            ( configUSE_EDF_READY_HEAP == 1 ) ? "ready heap" : "ready list", ( configUSE_EDF_BATCH_RELEASE == 1 ) ? ", batch release" : "",
+            uxNumTasks, ulPeriods, ( unsigned long ) benchPERIOD );
+    printf( "  release tick:     %10llu %s\n", ullTickTimes[ 0 ] / ulPeriods, benchUNIT );
+    printf( "  worst other tick: %10llu %s\n", ullWorstOther / ulPeriods, benchUNIT );
+    printf( "  all ticks:        %10llu %s per period\n", ullPeriod / ulPeriods, benchUNIT );
+    printf( "  xTaskDelayUntil:  %10llu %s per job\n", ( ulCounted != 0UL ) ? ( ullBlock / ulCounted ) : 0ULL, benchUNIT );
+
+    return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * Host simulation of the EDF scheduler with tickless idle.
+ *
+ * Host tool, not part of the target build.  tasks.c is built with the host
+ * port in this directory and the task set is played out against it to count
+ * the tick interrupts the processor still wakes up for.  Build and run with,
+ * FREERTOS being the FreeRTOS kernel source directory:
+ *
+ *     cc -O2 -I tools/edf_sim -I $FREERTOS/include -o edf_tickless \
+ *         tools/edf_sim/edf_tickless.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     ./edf_tickless tools/edf_tasks.csv [seconds]
+ *
+ * Add -DconfigUSE_EDF_TIMING_WHEEL=1 to run with the timing wheel.
+ *
+ * The task table is the one read by tools/edf_qpa.c, in microseconds.  Every
+ * job runs for its full wcet and completes with xTaskDelayUntil(), like the
+ * tasks in main.c.  Periods, deadlines and offsets must be whole ticks.
+ *
+ * When the ready queue is empty the idle task asks the port to sleep until the
+ * next release.  vPortSuppressTicksAndSleep() steps the tick count over the
+ * suppressed ticks, and only the tick interrupt that ends the sleep is taken.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include "../../tasks.c"
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#define simMAX_NAME_LEN    32
+#define simMAX_LINE_LEN    256
+#define simMAX_TASKS       64
+#define simUS_PER_TICK     ( 1000000UL / configTICK_RATE_HZ )
+
+typedef struct SimTask
+{
+    char pcName[ simMAX_NAME_LEN ];
+    unsigned long ulWcet;      /* Microseconds. */
+    TickType_t xPeriod;
+    TickType_t xDeadline;
+    TickType_t xOffset;
+    TaskHandle_t xHandle;
+    TickType_t xLastWakeTime;  /* Passed to xTaskDelayUntil(). */
+    unsigned long ulLeft;      /* Microseconds left in the current job. */
+    BaseType_t xStarted;
+} SimTask_t;
+
+static SimTask_t xSimTasks[ simMAX_TASKS ];
+static size_t uxNumSimTasks = 0;
+
+static unsigned long ulTickInterrupts = 0;
+static unsigned long ulSleeps = 0;
+static unsigned long ulSleptTicks = 0;
+static TickType_t xTicksLeft = 0; /* A sleep never goes past the end of the run. */
+
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    if( xExpectedIdleTime > xTicksLeft )
+    {
+        xExpectedIdleTime = xTicksLeft;
+    }
+
+    /* A job may have been released since the idle task looked. */
+    if( ( eTaskConfirmSleepModeStatus() != eAbortSleep ) && ( xExpectedIdleTime > ( TickType_t ) 1 ) )
+    {
+        /* The wakeup timer fires when the tick interrupt of the last
+         * suppressed tick is due.  That tick is processed as an ordinary
+         * tick interrupt, the ones before it are stepped over here. */
+        ulSleeps++;
+        ulSleptTicks += xExpectedIdleTime;
+        vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvSimTask, pvParameters )
+{
+    /* Never runs, the jobs are played out by prvRunTick(). */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+/* The tickless part of prvIdleTask(). */
+static void prvIdle( void )
+{
+    TickType_t xExpectedIdleTime;
+
+    xExpectedIdleTime = prvGetExpectedIdleTime();
+
+    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+    {
+        vTaskSuspendAll();
+        {
+            xExpectedIdleTime = prvGetExpectedIdleTime();
+
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            {
+                portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvCurrentSimTask( void )
+{
+    size_t x;
+
+    for( x = 0; x < uxNumSimTasks; x++ )
+    {
+        if( xSimTasks[ x ].xHandle == ( TaskHandle_t ) pxCurrentTCB )
+        {
+            return &xSimTasks[ x ];
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Runs the ready jobs for one tick period, then takes the tick interrupt.
+ * Returns the number of microseconds the processor was busy. */
+static unsigned long prvRunTick( void )
+{
+    unsigned long ulBudget = simUS_PER_TICK;
+    unsigned long ulRun;
+    SimTask_t * pxTask;
+
+    while( ( ulBudget > 0UL ) && ( ( pxTask = prvCurrentSimTask() ) != NULL ) )
+    {
+        if( pxTask->xStarted == pdFALSE )
+        {
+            /* The first job is released at the task's offset. */
+            pxTask->xStarted = pdTRUE;
+            pxTask->xLastWakeTime = pxCurrentTCB->xTaskReleaseTime;
+            pxTask->ulLeft = pxTask->ulWcet;
+        }
+
+        ulRun = ( pxTask->ulLeft < ulBudget ) ? pxTask->ulLeft : ulBudget;
+        pxTask->ulLeft -= ulRun;
+        ulBudget -= ulRun;
+
+        if( pxTask->ulLeft == 0UL )
+        {
+            pxTask->ulLeft = pxTask->ulWcet;
+            ( void ) xTaskDelayUntil( &( pxTask->xLastWakeTime ), pxTask->xPeriod );
+        }
+    }
+
+    if( ( TaskHandle_t ) pxCurrentTCB == xIdleTaskHandle )
+    {
+        prvIdle();
+    }
+
+    ulTickInterrupts++;
+
+    if( xTaskIncrementTick() != pdFALSE )
+    {
+        vTaskSwitchContext();
+    }
+
+    return simUS_PER_TICK - ulBudget;
+}
+/*-----------------------------------------------------------*/
+
+static char * prvTrim( char * pcString )
+{
+    char * pcEnd;
+
+    while( isspace( ( unsigned char ) *pcString ) )
+    {
+        pcString++;
+    }
+
+    pcEnd = pcString + strlen( pcString );
+
+    while( ( pcEnd > pcString ) && isspace( ( unsigned char ) pcEnd[ -1 ] ) )
+    {
+        pcEnd--;
+    }
+
+    *pcEnd = '\0';
+
+    return pcString;
+}
+/*-----------------------------------------------------------*/
+
+static int prvParseTime( char * pcField,
+                         unsigned long * pulValue )
+{
+    char * pcEnd;
+
+    pcField = prvTrim( pcField );
+    *pulValue = strtoul( pcField, &pcEnd, 10 );
+
+    return ( ( *pcField != '\0' ) && ( *pcEnd == '\0' ) && ( *pcField != '-' ) );
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadTaskTable( FILE * pxFile,
+                             const char * pcFileName )
+{
+    char pcLine[ simMAX_LINE_LEN ];
+    char * pcFields[ 5 ];
+    char * pcCursor;
+    unsigned long ulLine = 0;
+    unsigned long ulPeriod, ulDeadline, ulOffset;
+    size_t uxField;
+    SimTask_t * pxTask;
+
+    while( fgets( pcLine, sizeof( pcLine ), pxFile ) != NULL )
+    {
+        ulLine++;
+        pcCursor = prvTrim( pcLine );
+
+        if( ( *pcCursor == '\0' ) || ( *pcCursor == '#' ) )
+        {
+            continue;
+        }
+
+        for( uxField = 0; uxField < 5; uxField++ )
+        {
+            pcFields[ uxField ] = pcCursor;
+            pcCursor = strchr( pcCursor, ',' );
+
+            if( pcCursor == NULL )
+            {
+                break;
+            }
+
+            *pcCursor++ = '\0';
+        }
+
+        if( uxField != 4 )
+        {
+            fprintf( stderr, "%s:%lu: expected name, wcet, period, deadline, offset\n", pcFileName, ulLine );
+            return 0;
+        }
+
+        if( uxNumSimTasks == simMAX_TASKS )
+        {
+            fprintf( stderr, "%s:%lu: more than %d tasks\n", pcFileName, ulLine, simMAX_TASKS );
+            return 0;
+        }
+
+        pxTask = &xSimTasks[ uxNumSimTasks ];
+        snprintf( pxTask->pcName, sizeof( pxTask->pcName ), "%s", prvTrim( pcFields[ 0 ] ) );
+
+        if( !prvParseTime( pcFields[ 1 ], &pxTask->ulWcet ) ||
+            !prvParseTime( pcFields[ 2 ], &ulPeriod ) ||
+            !prvParseTime( pcFields[ 3 ], &ulDeadline ) ||
+            !prvParseTime( pcFields[ 4 ], &ulOffset ) )
+        {
+            fprintf( stderr, "%s:%lu: times must be non-negative integers\n", pcFileName, ulLine );
+            return 0;
+        }
+
+        if( ( ulPeriod == 0UL ) || ( ( ulPeriod % simUS_PER_TICK ) != 0UL ) ||
+            ( ( ulDeadline % simUS_PER_TICK ) != 0UL ) || ( ( ulOffset % simUS_PER_TICK ) != 0UL ) )
+        {
+            fprintf( stderr, "%s:%lu: %s: period, deadline and offset must be whole ticks of %lu us\n", pcFileName, ulLine, pxTask->pcName, simUS_PER_TICK );
+            return 0;
+        }
+
+        pxTask->xPeriod = ( TickType_t ) ( ulPeriod / simUS_PER_TICK );
+        pxTask->xDeadline = ( TickType_t ) ( ulDeadline / simUS_PER_TICK );
+        pxTask->xOffset = ( TickType_t ) ( ulOffset / simUS_PER_TICK );
+        uxNumSimTasks++;
+    }
+
+    return 1;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    FILE * pxFile;
+    unsigned long ulSeconds = 60UL;
+    unsigned long ulBusy = 0UL;
+    unsigned long ulMisses = 0UL;
+    UBaseType_t uxMisses;
+    TickType_t xWorstLateness;
+    TickType_t xRunTicks;
+    TickType_t xStart;
+    size_t x;
+
+    if( ( argc != 2 ) && ( argc != 3 ) )
+    {
+        fprintf( stderr, "usage: %s <task table> [seconds]\n", argv[ 0 ] );
+        return 2;
+    }
+
+    if( argc == 3 )
+    {
+        ulSeconds = strtoul( argv[ 2 ], NULL, 10 );
+    }
+
+    pxFile = fopen( argv[ 1 ], "r" );
+
+    if( pxFile == NULL )
+    {
+        perror( argv[ 1 ] );
+        return 2;
+    }
+
+    if( !prvReadTaskTable( pxFile, argv[ 1 ] ) )
+    {
+        fclose( pxFile );
+        return 2;
+    }
+
+    fclose( pxFile );
+
+    for( x = 0; x < uxNumSimTasks; x++ )
+    {
+        /* Admission control works in ticks, so the wcet is rounded up. */
+        if( xTaskPeriodicCreateConstrained( prvSimTask,
+                                            xSimTasks[ x ].pcName,
+                                            configMINIMAL_STACK_SIZE,
+                                            NULL,
+                                            1,
+                                            &( xSimTasks[ x ].xHandle ),
+                                            xSimTasks[ x ].xPeriod,
+                                            xSimTasks[ x ].xDeadline,
+                                            xSimTasks[ x ].xOffset,
+                                            ( TickType_t ) ( ( xSimTasks[ x ].ulWcet + simUS_PER_TICK - 1UL ) / simUS_PER_TICK ) ) != pdPASS )
+        {
+            fprintf( stderr, "%s: not admitted\n", xSimTasks[ x ].pcName );
+            return 2;
+        }
+    }
+
+    vTaskStartScheduler();
+
+    xRunTicks = ( TickType_t ) ( ulSeconds * configTICK_RATE_HZ );
+    xStart = xTaskGetTickCount();
+
+    while( ( xTaskGetTickCount() - xStart ) < xRunTicks )
+    {
+        xTicksLeft = xRunTicks - ( xTaskGetTickCount() - xStart );
+        ulBusy += prvRunTick();
+    }
+
+    for( x = 0; x < uxNumSimTasks; x++ )
+    {
+        vTaskGetDeadlineMissStats( xSimTasks[ x ].xHandle, &uxMisses, &xWorstLateness );
+        ulMisses += ( unsigned long ) uxMisses;
+    }
+
+    printf( "%zu tasks, %lu s simulated, busy %.1f %%\n", uxNumSimTasks, ulSeconds,
+            ( 100.0 * ( double ) ulBusy ) / ( ( double ) xRunTicks * ( double ) simUS_PER_TICK ) );
+    printf( "tick interrupts: %lu, %.1f per second (%lu without tickless idle)\n", ulTickInterrupts,
+            ( double ) ulTickInterrupts / ( double ) ulSeconds, ( unsigned long ) configTICK_RATE_HZ );
+    printf( "sleeps: %lu, %.1f ticks on average\n", ulSleeps,
+            ( ulSleeps != 0UL ) ? ( ( double ) ulSleptTicks / ( double ) ulSleeps ) : 0.0 );
+    printf( "deadline misses: %lu\n", ulMisses );
+
+    return ( ulMisses == 0UL ) ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+/*
+ * Host simulation of the task set of main.c across a tick count overflow.
+ *
+ * Host tool, not part of the target build.  The tick count starts 0x1000
+ * ticks before it wraps, and the task set is played out for long enough to
+ * cross the overflow.  Build and run with, FREERTOS being the FreeRTOS kernel
+ * source directory:
+ *
+ *     cc -O2 -I tools/edf_sim -I $FREERTOS/include -o edf_wrap \
+ *         tools/edf_sim/edf_wrap.c tools/edf_sim/port.c $FREERTOS/list.c
+ *     ./edf_wrap [wcet scale in percent]
+ *
+ * Add -DconfigUSE_EDF_READY_HEAP=1, -DconfigUSE_EDF_TIMING_WHEEL=1 or
+ * -DconfigUSE_EDF_BATCH_RELEASE=1 to check the other backends, and
+ * -DconfigINITIAL_TICK_COUNT=0 to run the same checks without the overflow.
+ *
+ * Every job runs for the wcet given for its task in tools/edf_tasks.csv and
+ * completes with xTaskDelayUntil(), like the tasks in main.c.  The tasks are
+ * released together, so while no deadline is missed the schedule repeats every
+ * hyperperiod of 100 ticks: every hyperperiod must complete all the jobs it
+ * releases and run the job with the same deadline at each tick as the second
+ * one, including the hyperperiod the tick count wraps in.  The first one is
+ * left out, as the tasks start from the state they were created in.  The
+ * deadline misses the kernel counts must match the jobs seen to complete
+ * late.
+ *
+ * The scale makes every job overrun its wcet, admission control still sees the
+ * wcets of the table.  Past about 160 % the task set is overloaded and the
+ * schedule no longer repeats, then only the miss counts are checked.  Exits
+ * with 0 when every check passes.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef configINITIAL_TICK_COUNT
+    #define configINITIAL_TICK_COUNT    ( ( TickType_t ) 0xFFFFF000UL )
+#endif
+
+/* The idle task does nothing in the simulation, so tickless idle would only
+ * skip ticks the checks look at. */
+#define configUSE_TICKLESS_IDLE    0
+
+#include "../../tasks.c"
+
+#include <stdio.h>
+
+#define simUS_PER_TICK         ( 1000000UL / configTICK_RATE_HZ )
+#define simHYPERPERIOD         ( ( TickType_t ) 100 )
+#define simHYPERPERIODS        82UL /* 8200 ticks, the default start wraps in the 41st. */
+#define simIDLE                portMAX_DELAY
+
+typedef struct SimTask
+{
+    const char * pcName;
+    unsigned long ulWcet;     /* Microseconds, as in tools/edf_tasks.csv. */
+    TickType_t xPeriod;       /* As in main.c.  Deadlines equal the periods. */
+    TaskHandle_t xHandle;
+    TickType_t xLastWakeTime; /* Passed to xTaskDelayUntil(), the release of the current job. */
+    unsigned long ulLeft;     /* Microseconds left in the current job. */
+    BaseType_t xStarted;
+    unsigned long ulJobs;
+    unsigned long ulLate;     /* Jobs that completed at or after their deadline. */
+    size_t uxCompleted;       /* Jobs completed in the current hyperperiod. */
+} SimTask_t;
+
+static SimTask_t xSimTasks[] =
+{
+    { "Button_1_Monitor",     18UL,    50 },
+    { "Button_2_Monitor",     18UL,    50 },
+    { "Periodic_Transmitter", 20UL,    100 },
+    { "Uart_Receiver",        63UL,    20 },
+    { "Load_1_Simulation",    5000UL,  10 },
+    { "Load_2_Simulation",    12000UL, 100 }
+};
+
+#define simNUM_TASKS    ( sizeof( xSimTasks ) / sizeof( xSimTasks[ 0 ] ) )
+
+static TickType_t xSchedule[ simHYPERPERIOD ]; /* Deadline of the running job at each tick of the second hyperperiod, from its start. */
+static unsigned long ulHyperperiod = 0;
+static TickType_t xHyperperiodStart = configINITIAL_TICK_COUNT;
+static TickType_t xHyperperiodTick = 0;
+static BaseType_t xCheckSchedule = pdTRUE;
+static unsigned long ulScheduleErrors = 0;
+
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvSimTask, pvParameters )
+{
+    /* Never runs, the jobs are played out by prvRunTick(). */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvCurrentSimTask( void )
+{
+    size_t x;
+
+    for( x = 0; x < simNUM_TASKS; x++ )
+    {
+        if( xSimTasks[ x ].xHandle == ( TaskHandle_t ) pxCurrentTCB )
+        {
+            return &xSimTasks[ x ];
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Called as the tick interrupt is taken.  Jobs with equal deadlines may run in
+ * either order, so the schedule is compared by the deadline of the job that
+ * was running, which EDF decides on its own. */
+static void prvCheckTick( void )
+{
+    SimTask_t * pxTask = prvCurrentSimTask();
+    TickType_t xDeadline = simIDLE;
+
+    if( pxTask != NULL )
+    {
+        xDeadline = ( pxTask->xLastWakeTime + pxTask->xPeriod ) - xHyperperiodStart;
+    }
+
+    if( ulHyperperiod == 1UL )
+    {
+        xSchedule[ xHyperperiodTick ] = xDeadline;
+    }
+    else if( ( ulHyperperiod > 1UL ) && ( xCheckSchedule != pdFALSE ) && ( xSchedule[ xHyperperiodTick ] != xDeadline ) )
+    {
+        if( ulScheduleErrors == 0UL )
+        {
+            printf( "hyperperiod %lu, tick %lu: deadline %lu, expected %lu\n", ulHyperperiod, ( unsigned long ) xHyperperiodTick,
+                    ( unsigned long ) xDeadline, ( unsigned long ) xSchedule[ xHyperperiodTick ] );
+        }
+
+        ulScheduleErrors++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Runs the ready jobs for one tick period, then takes the tick interrupt. */
+static void prvRunTick( void )
+{
+    unsigned long ulBudget = simUS_PER_TICK;
+    unsigned long ulRun;
+    SimTask_t * pxTask;
+    size_t x;
+
+    while( ( ulBudget > 0UL ) && ( ( pxTask = prvCurrentSimTask() ) != NULL ) )
+    {
+        if( pxTask->xStarted == pdFALSE )
+        {
+            pxTask->xStarted = pdTRUE;
+            pxTask->xLastWakeTime = pxCurrentTCB->xTaskReleaseTime;
+        }
+
+        ulRun = ( pxTask->ulLeft < ulBudget ) ? pxTask->ulLeft : ulBudget;
+        pxTask->ulLeft -= ulRun;
+        ulBudget -= ulRun;
+
+        if( pxTask->ulLeft == 0UL )
+        {
+            /* The kernel counts a miss once the tick count reaches the
+             * deadline with the job not completed. */
+            if( ( TickType_t ) ( xTickCount - pxTask->xLastWakeTime ) >= pxTask->xPeriod )
+            {
+                pxTask->ulLate++;
+            }
+
+            pxTask->ulJobs++;
+            pxTask->ulLeft = pxTask->ulWcet;
+            pxTask->uxCompleted++;
+            ( void ) xTaskDelayUntil( &( pxTask->xLastWakeTime ), pxTask->xPeriod );
+        }
+    }
+
+    prvCheckTick();
+
+    if( xTaskIncrementTick() != pdFALSE )
+    {
+        vTaskSwitchContext();
+    }
+
+    xHyperperiodTick++;
+
+    if( xHyperperiodTick == simHYPERPERIOD )
+    {
+        /* Every job released in the hyperperiod has completed in it. */
+        for( x = 0; x < simNUM_TASKS; x++ )
+        {
+            if( ( xCheckSchedule != pdFALSE ) && ( xSimTasks[ x ].uxCompleted != ( size_t ) ( simHYPERPERIOD / xSimTasks[ x ].xPeriod ) ) )
+            {
+                ulScheduleErrors++;
+            }
+
+            xSimTasks[ x ].uxCompleted = 0;
+        }
+
+        xHyperperiodStart += simHYPERPERIOD;
+        xHyperperiodTick = 0;
+        ulHyperperiod++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    unsigned long ulScale = 100UL;
+    unsigned long ulLate = 0UL, ulMismatches = 0UL, ulOverdue;
+    unsigned long ulUtilisation = 0UL; /* Parts per million. */
+    UBaseType_t uxMisses;
+    TickType_t xWorstLateness, xSinceRelease;
+    size_t x;
+
+    if( argc > 2 )
+    {
+        fprintf( stderr, "usage: %s [wcet scale in percent]\n", argv[ 0 ] );
+        return 2;
+    }
+
+    if( argc == 2 )
+    {
+        ulScale = strtoul( argv[ 1 ], NULL, 10 );
+    }
+
+    for( x = 0; x < simNUM_TASKS; x++ )
+    {
+        /* Admission control works in ticks, so the wcet is rounded up. */
+        if( xTaskPeriodicCreateConstrained( prvSimTask,
+                                            xSimTasks[ x ].pcName,
+                                            configMINIMAL_STACK_SIZE,
+                                            NULL,
+                                            1,
+                                            &( xSimTasks[ x ].xHandle ),
+                                            xSimTasks[ x ].xPeriod,
+                                            xSimTasks[ x ].xPeriod,
+                                            ( TickType_t ) 0,
+                                            ( TickType_t ) ( ( xSimTasks[ x ].ulWcet + simUS_PER_TICK - 1UL ) / simUS_PER_TICK ) ) != pdPASS )
+        {
+            fprintf( stderr, "%s: not admitted\n", xSimTasks[ x ].pcName );
+            return 2;
+        }
+
+        xSimTasks[ x ].ulWcet = ( ( xSimTasks[ x ].ulWcet * ulScale ) + 99UL ) / 100UL;
+        xSimTasks[ x ].ulLeft = xSimTasks[ x ].ulWcet;
+        ulUtilisation += ( xSimTasks[ x ].ulWcet * 1000UL ) / ( unsigned long ) xSimTasks[ x ].xPeriod;
+    }
+
+    /* An overloaded task set has no steady schedule to compare with. */
+    xCheckSchedule = ( ulUtilisation <= ( unsigned long ) simUS_PER_TICK * 1000UL ) ? pdTRUE : pdFALSE;
+
+    vTaskStartScheduler();
+
+    printf( "tick count %#lx to %#lx, wcets at %lu %%, utilisation %.1f %%\n",
+            ( unsigned long ) configINITIAL_TICK_COUNT,
+            ( unsigned long ) ( TickType_t ) ( configINITIAL_TICK_COUNT + ( simHYPERPERIOD * simHYPERPERIODS ) ),
+            ulScale, ( double ) ulUtilisation / ( ( double ) simUS_PER_TICK * 10.0 ) );
+
+    while( ulHyperperiod < simHYPERPERIODS )
+    {
+        prvRunTick();
+    }
+
+    for( x = 0; x < simNUM_TASKS; x++ )
+    {
+        vTaskGetDeadlineMissStats( xSimTasks[ x ].xHandle, &uxMisses, &xWorstLateness );
+        printf( "%-22s %5lu jobs, %4lu late, %4lu misses counted\n", xSimTasks[ x ].pcName,
+                xSimTasks[ x ].ulJobs, xSimTasks[ x ].ulLate, ( unsigned long ) uxMisses );
+        ulLate += xSimTasks[ x ].ulLate;
+
+        /* The job in progress has been counted already if its deadline has
+         * passed, as the tick checks every ready job. */
+        xSinceRelease = xTickCount - ( ( TCB_t * ) xSimTasks[ x ].xHandle )->xTaskReleaseTime;
+        ulOverdue = ( ( xSinceRelease < ( portMAX_DELAY >> 1 ) ) && ( xSinceRelease >= xSimTasks[ x ].xPeriod ) ) ? 1UL : 0UL;
+
+        if( ( unsigned long ) uxMisses != ( xSimTasks[ x ].ulLate + ulOverdue ) )
+        {
+            ulMismatches++;
+        }
+    }
+
+    if( xCheckSchedule != pdFALSE )
+    {
+        printf( "schedule: %lu hyperperiods, %lu ticks differ from the second\n",
+                simHYPERPERIODS, ulScheduleErrors );
+    }
+    else
+    {
+        printf( "schedule: overloaded, not checked\n" );
+    }
+
+    if( ( ulScheduleErrors != 0UL ) || ( ulMismatches != 0UL ) || ( ( xCheckSchedule != pdFALSE ) && ( ulLate != 0UL ) ) )
+    {
+        printf( "FAIL\n" );
+        return 1;
+    }
+
+    printf( "PASS\n" );
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Host port used by the simulations in this directory.
+ *
+ * There is no context switch.  A simulation plays the part of whichever task
+ * pxCurrentTCB points at, so a yield only has to select the next task.  Each
+ * simulation provides vPortSuppressTicksAndSleep() itself.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    vTaskSwitchContext();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    ( void ) pxCode;
+    ( void ) pvParameters;
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    /* Return to main(), which runs the simulation. */
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return malloc( xWantedSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    free( pv );
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "assertion failed at %s:%lu\n", pcFile, ulLine );
+    exit( 2 );
+}